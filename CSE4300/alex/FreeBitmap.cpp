@@ -0,0 +1,92 @@
+#include <stdexcept>
+#include "FreeBitmap.h"
+
+// index of the lowest set bit; word must not be 0
+static int countTrailingZeros(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    int count = 0;
+    while ((word & 1) == 0) {
+        word >>= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+// constructors
+
+FreeBitmap:: FreeBitmap()
+: FreeBitmap(0){
+}
+
+FreeBitmap:: FreeBitmap(int size, bool allFree)
+: SIZE(size){
+    if (size < 0) throw std::invalid_argument("Bitmap size must not be negative");
+
+    // build levels until one word covers everything below it
+    int slots = size;
+    do {
+        int words = (slots + 63) / 64;
+        if (words == 0) words = 1;
+        levels.emplace_back(words, 0);
+        slots = words;
+    } while (slots > 1);
+
+    if (allFree) {
+        for (int i = 0; i < size; i++) _setBit(i, true);
+        freeSlots = size;
+    }
+}
+
+// private methods
+
+void FreeBitmap:: _setBit(int index, bool free) {
+    for (auto& level : levels) {
+        uint64_t& word = level[index / 64];
+        uint64_t bit = uint64_t(1) << (index % 64);
+        bool wasEmpty = word == 0;
+
+        if (free) word |= bit;
+        else word &= ~bit;
+
+        // the summary bit above only changes when this word goes between empty and not empty
+        if (wasEmpty == (word == 0)) return;
+        index /= 64;
+    }
+}
+
+// public methods
+
+void FreeBitmap:: markFree(int index) {
+    if (index < 0 || index >= SIZE) throw std::out_of_range("Bitmap index out of bounds");
+    if (isFree(index)) return;
+
+    _setBit(index, true);
+    freeSlots++;
+}
+
+void FreeBitmap:: markUsed(int index) {
+    if (index < 0 || index >= SIZE) throw std::out_of_range("Bitmap index out of bounds");
+    if (!isFree(index)) return;
+
+    _setBit(index, false);
+    freeSlots--;
+}
+
+bool FreeBitmap:: isFree(int index) const {
+    if (index < 0 || index >= SIZE) throw std::out_of_range("Bitmap index out of bounds");
+    return (levels[0][index / 64] >> (index % 64)) & 1;
+}
+
+int FreeBitmap:: findFirstFree() const {
+    if (freeSlots == 0) return -1;
+
+    // walk down from the single top word, picking the lowest non-empty word each time
+    int index = 0;
+    for (int level = levels.size() - 1; level >= 0; level--) {
+        index = index * 64 + countTrailingZeros(levels[level][index]);
+    }
+    return index;
+}
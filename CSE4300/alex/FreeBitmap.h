@@ -0,0 +1,37 @@
+#include <vector>
+#include <cstdint>
+
+#ifndef FREEBITMAP_H
+#define FREEBITMAP_H
+
+// Tracks which of a fixed number of slots (frames, virtual pages) are free.
+// Bits are grouped into 64-bit words, and each level above keeps one bit per word
+// of the level below saying "this word has a free slot", so finding the lowest free
+// slot is one count-trailing-zeros per level instead of a scan over every slot.
+class FreeBitmap {
+    private:
+        std::vector<std::vector<uint64_t>> levels; // levels[0] has one bit per slot, the last level is a single word
+        int SIZE;
+        int freeSlots = 0;
+
+        // set or clear a slot's bit and fix up the summary bits above it. internal use
+        void _setBit(int index, bool free);
+
+    public:
+        FreeBitmap();
+        // size slots, all free or all in use
+        explicit FreeBitmap(int size, bool allFree = true);
+
+        // mark a slot free/in use
+        void markFree(int index);
+        void markUsed(int index);
+        bool isFree(int index) const;
+
+        // lowest free slot, or -1 if everything is in use
+        int findFirstFree() const;
+
+        int size() const { return SIZE; }
+        int freeCount() const { return freeSlots; }
+};
+
+#endif
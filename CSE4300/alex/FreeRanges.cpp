@@ -0,0 +1,81 @@
+#include <stdexcept>
+#include "FreeRanges.h"
+
+// constructors
+
+FreeRanges:: FreeRanges()
+: FreeRanges(0){
+}
+
+FreeRanges:: FreeRanges(int64_t size)
+: SIZE(size){
+    if (size < 0) throw std::invalid_argument("Range size must not be negative");
+
+    if (size > 0) ranges[0] = size;
+    freeSlots = size;
+}
+
+// private methods
+
+std::map<int64_t, int64_t>::const_iterator FreeRanges:: _findRun(int64_t index) const {
+    // the only run that can hold index is the last one starting at or before it
+    auto run = ranges.upper_bound(index);
+    if (run == ranges.begin()) return ranges.end();
+    --run;
+    return index < run->second ? run : ranges.end();
+}
+
+// public methods
+
+void FreeRanges:: markFree(int64_t index) {
+    if (index < 0 || index >= SIZE) throw std::out_of_range("Range index out of bounds");
+    if (isFree(index)) return;
+
+    int64_t start = index;
+    int64_t end = index + 1;
+
+    // merge with a run ending right before it and one starting right after it
+    auto next = ranges.find(end);
+    if (next != ranges.end()) {
+        end = next->second;
+        ranges.erase(next);
+    }
+    auto previous = ranges.lower_bound(index);
+    if (previous != ranges.begin()) {
+        --previous;
+        if (previous->second == index) {
+            previous->second = end;
+            freeSlots++;
+            return;
+        }
+    }
+
+    ranges[start] = end;
+    freeSlots++;
+}
+
+void FreeRanges:: markUsed(int64_t index) {
+    if (index < 0 || index >= SIZE) throw std::out_of_range("Range index out of bounds");
+
+    auto run = _findRun(index);
+    if (run == ranges.end()) return;
+
+    int64_t start = run->first;
+    int64_t end = run->second;
+    ranges.erase(run);
+
+    // split around the slot
+    if (start < index) ranges[start] = index;
+    if (index + 1 < end) ranges[index + 1] = end;
+    freeSlots--;
+}
+
+bool FreeRanges:: isFree(int64_t index) const {
+    if (index < 0 || index >= SIZE) throw std::out_of_range("Range index out of bounds");
+    return _findRun(index) != ranges.end();
+}
+
+int64_t FreeRanges:: findFirstFree() const {
+    if (ranges.empty()) return -1;
+    return ranges.begin()->first;
+}
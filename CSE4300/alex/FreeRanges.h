@@ -0,0 +1,40 @@
+#include <map>
+#include <cstdint>
+#include <cstddef>
+
+#ifndef FREERANGES_H
+#define FREERANGES_H
+
+// Tracks free slots in a huge index space (virtual pages of a 48-bit address space) as a
+// sorted set of free runs [start, end). Memory grows with how fragmented the space is,
+// not with its size, so it works where a bitmap with one bit per slot would not fit.
+// Same interface as FreeBitmap.
+class FreeRanges {
+    private:
+        std::map<int64_t, int64_t> ranges; // start -> end (exclusive), runs never touch each other
+        int64_t SIZE;
+        int64_t freeSlots = 0;
+
+        // run containing index, or ranges.end(). internal use
+        std::map<int64_t, int64_t>::const_iterator _findRun(int64_t index) const;
+
+    public:
+        FreeRanges();
+        // size slots, all free
+        explicit FreeRanges(int64_t size);
+
+        // mark a slot free/in use
+        void markFree(int64_t index);
+        void markUsed(int64_t index);
+        bool isFree(int64_t index) const;
+
+        // lowest free slot, or -1 if everything is in use
+        int64_t findFirstFree() const;
+
+        int64_t size() const { return SIZE; }
+        int64_t freeCount() const { return freeSlots; }
+        // number of separate free runs, i.e. how fragmented the space is
+        size_t runCount() const { return ranges.size(); }
+};
+
+#endif
@@ -1,4 +1,6 @@
 #include <iostream>
+#include <cstring>
+#include <algorithm>
 #include <stdexcept> // will fix error handling laterrrr
 #include "MemoryManager.h"
 
@@ -9,23 +11,93 @@
 // constructors
 
 MemoryManager:: MemoryManager()
-: PAGE_SIZE(4096), PAGE_COUNT(1024), PHYSICAL_SIZE(4096*1024){
-    _initializeMemory();
+: PAGE_SIZE(4096), PAGE_COUNT(1024), PHYSICAL_SIZE(4096*1024), replacementPolicy(std::make_unique<ClockPolicy>()){
+    _initializeMemory("flat");
 }
 
-MemoryManager:: MemoryManager(int page_size, int num_pages, int num_frames)
-: PAGE_SIZE(page_size), PAGE_COUNT(num_pages), PHYSICAL_SIZE(num_frames * page_size){
-    _initializeMemory();
+MemoryManager:: MemoryManager(int page_size, int64_t num_pages, int num_frames, const std::string& page_table)
+: PAGE_SIZE(page_size), PAGE_COUNT(num_pages), PHYSICAL_SIZE(num_frames * page_size), replacementPolicy(std::make_unique<ClockPolicy>()){
+    _initializeMemory(page_table);
 }
 
 // private methods
 
-void MemoryManager:: _initializeMemory() {
-    pageTable.resize(PAGE_COUNT);
+void MemoryManager:: _initializeMemory(const std::string& pageTableName) {
+    // offsets are taken with a mask and VPNs with a shift, so pages must be a power of two
+    if (PAGE_SIZE <= 0 || (PAGE_SIZE & (PAGE_SIZE - 1)) != 0)
+        throw std::invalid_argument("Page size must be a power of 2");
+
+    PAGE_SHIFT = 0;
+    while ((1 << PAGE_SHIFT) < PAGE_SIZE) PAGE_SHIFT++;
+
+    // virtual addresses have to fit in 63 bits, and VPNs have to fit under the ASID in a page key
+    if (PAGE_COUNT < 0 || PAGE_COUNT > (INT64_MAX >> PAGE_SHIFT) || PAGE_COUNT > ((int64_t)1 << ASID_SHIFT))
+        throw std::invalid_argument("Virtual address space too large");
+
     physicalMemory.resize(PHYSICAL_SIZE);
-    freeFrames.resize(PHYSICAL_SIZE / PAGE_SIZE, true);
+    freeFrames = FreeBitmap(PHYSICAL_SIZE / PAGE_SIZE);
+    frameToVPN.assign(PHYSICAL_SIZE / PAGE_SIZE, -1);
+    frameSharers.clear();
+
+    pageTableType = pageTableName;
+    addressSpaces.clear();
+    addressSpaces.emplace(0, _makeAddressSpace());
+    currentASID = 0;
+    nextASID = 1;
+
+    // disk space is handed out as pages get written out, so sparse address spaces stay cheap
+    diskStorage.clear();
+}
+
+MemoryManager::addressSpace& MemoryManager:: _space(int asid) {
+    auto found = addressSpaces.find(asid);
+    if (found == addressSpaces.end())
+        throw std::out_of_range("No address space with ASID " + std::to_string(asid));
+
+    return found->second;
+}
+
+pageTableEntry* MemoryManager:: _entry(int64_t pageKey) {
+    if (pageKey < 0 || _vpnOf(pageKey) >= PAGE_COUNT) return nullptr;
+
+    auto found = addressSpaces.find(_asidOf(pageKey));
+    if (found == addressSpaces.end()) return nullptr;
+    return found->second.pageTable->find(_vpnOf(pageKey));
+}
+
+pageTableEntry* MemoryManager::pageKeyLookup:: find(int64_t pageKey) {
+    if (asid != -1 && _asidOf(pageKey) != asid) return nullptr;
+    return manager._entry(pageKey);
+}
+
+ReplacementPolicy& MemoryManager:: _policyFor(int64_t pageKey) {
+    if (replacementScope == ReplacementScope::GLOBAL) return *replacementPolicy;
+    return *_space(_asidOf(pageKey)).replacementPolicy;
+}
+
+MemoryManager::addressSpace MemoryManager:: _makeAddressSpace() {
+    addressSpace space;
+    space.pageTable = createPageTable(pageTableType, PAGE_COUNT, PHYSICAL_SIZE / PAGE_SIZE);
+    if (!space.pageTable)
+        throw std::invalid_argument("Unknown page table type: " + pageTableType);
+
+    space.freeVPNs = FreeRanges(PAGE_COUNT);
+    if (replacementScope == ReplacementScope::PER_PROCESS)
+        space.replacementPolicy = _policyLike(replacementPolicy->getName());
+    return space;
+}
 
-    diskStorage.resize(PAGE_COUNT * PAGE_SIZE); // give disk space for every entry
+std::unique_ptr<ReplacementPolicy> MemoryManager:: _policyLike(const std::string& name) {
+    std::unique_ptr<ReplacementPolicy> policy = createReplacementPolicy(name, PHYSICAL_SIZE / PAGE_SIZE);
+    if (!policy) policy = std::make_unique<ClockPolicy>();
+    return policy;
+}
+
+void MemoryManager:: _replayResident(ReplacementPolicy& policy, int asid) {
+    // a policy only follows a frame through its owner, sharers never show up in it
+    for (int64_t pageKey : frameToVPN) {
+        if (pageKey >= 0 && (asid == -1 || _asidOf(pageKey) == asid)) policy.onLoad(pageKey);
+    }
 }
 
 void MemoryManager:: _writeMemory(int physicalAddress, uint8_t data) {
@@ -42,224 +114,828 @@ uint8_t MemoryManager:: _readMemory(int physicalAddress) {
     return physicalMemory[physicalAddress];
 }
 
-void MemoryManager:: _allocatePage(int virtualPageNumber, int frameNumber) {
+void MemoryManager:: _allocatePage(int64_t pageKey, int frameNumber) {
+    int64_t virtualPageNumber = _vpnOf(pageKey);
     if (virtualPageNumber >= PAGE_COUNT || virtualPageNumber < 0)
         throw std::out_of_range("Invalid virtual page number");
     if (frameNumber >= (PHYSICAL_SIZE / PAGE_SIZE) || frameNumber < 0)
         throw std::out_of_range("Invalid frame number");
 
-    pageTableEntry& entry = pageTable[virtualPageNumber];
+    addressSpace& space = _space(_asidOf(pageKey));
+    space.pageTable->insert(virtualPageNumber);
+    space.pageTable->map(virtualPageNumber, frameNumber);
+    space.residentPages++;
 
+    freeFrames.markUsed(frameNumber);
+    space.freeVPNs.markUsed(virtualPageNumber);
+    _setFrameOwner(frameNumber, pageKey);
 
-    entry.validBit = true;
-    entry.pageFrameNum = frameNumber;
-    entry.presentBit = true;
+    _policyFor(pageKey).onLoad(pageKey);
+    _countResident(pageKey, 1);
+}
+
+void MemoryManager:: _setFrameOwner(int frameNumber, int64_t pageKey) {
+    int64_t previous = frameToVPN[frameNumber];
+    if (previous >= 0) _space(_asidOf(previous)).ownedFrames--;
 
-    freeFrames[frameNumber] = false;
+    frameToVPN[frameNumber] = pageKey;
+    if (pageKey >= 0) _space(_asidOf(pageKey)).ownedFrames++;
 }
 
-int MemoryManager:: _virtualToPhysicalAddress(int virtualAddress, bool writeOperation) {
+int MemoryManager:: _virtualToPhysicalAddress(int64_t virtualAddress, bool writeOperation) {
     // first let's calculate the offset and find the virtual page number
-    int offset = virtualAddress & (PAGE_SIZE - 1); // offset is based on the size of each page
-    int virtualPageNumber = virtualAddress / PAGE_SIZE; // essentially shifts the number right by 12 bits
+    int offset = (int)(virtualAddress & (PAGE_SIZE - 1)); // offset is based on the size of each page
+    int64_t virtualPageNumber = virtualAddress >> PAGE_SHIFT; // shifts the number right by 12 bits for 4K pages
 
     // now lets validate the virtual address (bounds and valid bit)
     if (virtualPageNumber >= PAGE_COUNT || virtualPageNumber < 0)
         throw std::out_of_range("Attempted to access out-of-bound virtual address");
 
-    pageTableEntry& entry = pageTable[virtualPageNumber];
+    int64_t pageKey = _pageKey(currentASID, virtualPageNumber);
+    PageTable& pageTable = *addressSpaces.at(currentASID).pageTable;
+
+    // a filler page that gets used is no longer wasted
+    if (!hugeFillers.empty()) hugeFillers.erase(pageKey);
+
+    // TLB hit: the page is known valid and present, skip the table walk. a write to a
+    // copy-on-write page still goes the long way round so it gets its own frame
+    int cachedFrame;
+    if (tlb.lookup(currentASID, virtualPageNumber, cachedFrame)) {
+        pageTableEntry* entry = pageTable.find(virtualPageNumber);
+        if (!(writeOperation && entry->copyOnWriteBit)) {
+            _markAccessed(pageKey, entry, writeOperation);
+            int64_t owner = frameToVPN[cachedFrame];
+            _policyFor(owner).onAccess(owner, writeOperation);
+            return (cachedFrame << PAGE_SHIFT) + offset;
+        }
+    }
+
+    // an inverted table only holds resident pages, so a failed walk still has to check the OS's records
+    pageTableEntry* entry = pageTable.walk(virtualPageNumber);
+    if (!entry) entry = pageTable.find(virtualPageNumber);
 
-    if (!entry.validBit)
+    if (!entry)
         throw std::runtime_error("Segmentation fault occurred: Invalid page accessed");
 
-    if (!entry.presentBit) {
-        _handlePageFault(virtualPageNumber);
+    if (!entry->presentBit) {
+        _handlePageFault(pageKey);
+        entry = pageTable.find(virtualPageNumber); // loading the page can move its entry
+    } else if (writeOperation && entry->copyOnWriteBit) {
+        _breakCopyOnWrite(pageKey);
+        entry = pageTable.find(virtualPageNumber);
+    } else {
+        int64_t owner = frameToVPN[entry->pageFrameNum];
+        _policyFor(owner).onAccess(owner, writeOperation);
     }
 
     // now we can map the virtual to the physical
-    int pageFrameNum = entry.pageFrameNum;
+    int pageFrameNum = entry->pageFrameNum;
     int physicalAddress = (pageFrameNum * PAGE_SIZE) + offset;
 
     if (physicalAddress >= PHYSICAL_SIZE || physicalAddress < 0)
         throw std::out_of_range("Physical address out of bounds");
 
-    entry.referenceBit = true;
-    if (writeOperation) entry.modifyBit = true;
+    _markAccessed(pageKey, entry, writeOperation);
+
+    tlb.insert(currentASID, virtualPageNumber, pageFrameNum, entry->hugeBit);
 
     return physicalAddress;
 }
 
-void MemoryManager:: _handlePageFault(int virtualPageNumber){
-    std::cout << "Page fault at VPN: " <<virtualPageNumber << std::endl;
+void MemoryManager:: _markAccessed(int64_t pageKey, pageTableEntry* entry, bool writeOperation) {
+    entry->referenceBit = true;
+    if (writeOperation) entry->modifyBit = true;
 
-    pageTableEntry& entry = pageTable[virtualPageNumber];
+    // policies read the bits of the frame's owner, so a sharer's use has to show up there
+    int64_t owner = frameToVPN[entry->pageFrameNum];
+    if (owner != pageKey) _entry(owner)->referenceBit = true;
+}
 
-    // check for free frame, if none, page replacement
-    int freeFrame = -1;
-    for (int i = 0; i < freeFrames.size(); i++) {
-        if (freeFrames[i]) {
-            freeFrame = i;
-            break;
-        }
-    }
+void MemoryManager:: _validateRange(int64_t virtualAddress, int length) {
+    if (length < 0)
+        throw std::invalid_argument("Length must not be negative");
+    if (length == 0) return;
 
-    if (freeFrame == -1) {
-        entry.pageFrameNum = _replacePage();
-    } else
-        entry.pageFrameNum = freeFrame;
+    // check the whole range up front so a bad page doesn't leave a half finished copy
+    int64_t lastAddress = virtualAddress + length - 1;
+    if (virtualAddress < 0 || lastAddress >= PAGE_COUNT << PAGE_SHIFT)
+        throw std::out_of_range("Attempted to access out-of-bound virtual address");
 
-    _readPageFromDisk(virtualPageNumber, entry.pageFrameNum);
+    PageTable& pageTable = *addressSpaces.at(currentASID).pageTable;
+    int64_t firstPage = virtualAddress >> PAGE_SHIFT;
+    int64_t lastPage = lastAddress >> PAGE_SHIFT;
+    for (int64_t vpn = firstPage; vpn <= lastPage; vpn++) {
+        if (!pageTable.find(vpn))
+            throw std::runtime_error("Segmentation fault occurred: Invalid page accessed");
+    }
+}
+
+void MemoryManager:: _handlePageFault(int64_t pageKey){
+    if (verbose) {
+        std::cout << "Page fault at VPN: " << _vpnOf(pageKey);
+        if (addressSpaces.size() > 1) std::cout << " (ASID " << _asidOf(pageKey) << ")";
+        std::cout << std::endl;
+    }
+    pageFaults++;
+    _space(_asidOf(pageKey)).pageFaults++;
 
-    freeFrames[entry.pageFrameNum] = false;
+    // check for free frame, if none, page replacement
+    int freeFrame = _takeFrame(pageKey);
 
-    entry.presentBit = true;
+    _loadPage(pageKey, freeFrame);
 }
 
-int MemoryManager:: _replacePage() {
-    std::cout << "No free frame found, replacing page" << std::endl;
+void MemoryManager:: _loadPage(int64_t pageKey, int frameNumber) {
+    _readPageFromDisk(pageKey, frameNumber);
 
-    int frameNumber = -1;
-    int replacedVPN = -1;
-    bool entryWasModified = false;
+    freeFrames.markUsed(frameNumber);
+    _setFrameOwner(frameNumber, pageKey);
 
-    bool ticking = true;
-    while (ticking) {
-        if (clockPointer == PAGE_COUNT) clockPointer = 0;
+    addressSpace& space = _space(_asidOf(pageKey));
+    space.pageTable->map(_vpnOf(pageKey), frameNumber);
+    space.residentPages++;
 
-        pageTableEntry& entry = pageTable[clockPointer];
+    _policyFor(pageKey).onLoad(pageKey);
+    _countResident(pageKey, 1);
+    _tryPromote(pageKey >> HUGE_SHIFT);
+}
 
-        if (entry.presentBit) {
-            if (entry.referenceBit) {
-                entry.referenceBit = false;
-            } else {
-                entry.presentBit = false;
-                frameNumber = entry.pageFrameNum;
-                replacedVPN = clockPointer;
-                entryWasModified = entry.modifyBit;
-                ticking = false;
+int MemoryManager:: _takeFrame(int64_t incomingKey) {
+    int frameNumber = freeFrames.findFirstFree();
+    if (frameNumber == -1) frameNumber = _replacePage(incomingKey);
+    return frameNumber;
+}
+
+int MemoryManager:: _replacePage(int64_t incomingKey) {
+    if (verbose) std::cout << "No free frame found, replacing page" << std::endl;
+
+    // per-process replacement takes a frame from the faulting process, unless it has none to
+    // give up; then the process holding the most frames pays
+    ReplacementPolicy* policy = replacementPolicy.get();
+    int scope = -1;
+    if (replacementScope == ReplacementScope::PER_PROCESS) {
+        scope = _asidOf(incomingKey);
+        if (_space(scope).ownedFrames == 0) {
+            for (auto& space : addressSpaces) {
+                if (space.second.ownedFrames > _space(scope).ownedFrames) scope = space.first;
             }
         }
+        policy = _space(scope).replacementPolicy.get();
+    }
+
+    pageKeyLookup lookup(*this, scope);
+    int64_t replacedKey = policy->chooseVictim(incomingKey, lookup, frameToVPN);
+    pageTableEntry* entry = lookup.find(replacedKey);
+    if (!entry || !entry->presentBit || frameToVPN[entry->pageFrameNum] != replacedKey)
+        throw std::logic_error("Replacement policy chose a page that is not in memory");
+
+    // memory pressure splits a huge page, only the victim leaves memory
+    if (entry->hugeBit) {
+        _demote(replacedKey >> HUGE_SHIFT, replacedKey);
+        entry = _entry(replacedKey);
+    }
 
-        clockPointer++;
+    int frameNumber = entry->pageFrameNum;
+    pageEvictions++;
+
+    // every page mapping the frame leaves memory with it, each with a copy of its own on disk
+    std::vector<int64_t> mappers = {replacedKey};
+    auto sharers = frameSharers.find(frameNumber);
+    if (sharers != frameSharers.end()) {
+        mappers.insert(mappers.end(), sharers->second.begin(), sharers->second.end());
+        frameSharers.erase(sharers);
     }
 
-    if (entryWasModified) _writePageToDisk(replacedVPN);
+    for (int64_t pageKey : mappers) {
+        pageTableEntry* mapped = _entry(pageKey);
+        if (mapped->modifyBit) {
+            _writePageToDisk(pageKey, frameNumber);
+            diskWrites++;
+        }
+
+        tlb.invalidate(_asidOf(pageKey), _vpnOf(pageKey));
+
+        // disk now holds the current copy
+        mapped->referenceBit = false;
+        mapped->modifyBit = false;
+        mapped->copyOnWriteBit = false;
+
+        addressSpace& space = _space(_asidOf(pageKey));
+        space.pageTable->unmap(_vpnOf(pageKey));
+        space.residentPages--;
+        _countResident(pageKey, -1);
+    }
 
-    freeFrames[frameNumber] = true;
-    pageTable[replacedVPN].pageFrameNum = -1;
+    freeFrames.markFree(frameNumber);
+    _setFrameOwner(frameNumber, -1);
     _wipeMemoryFrame(frameNumber);
 
     return frameNumber;
 }
 
+void MemoryManager:: _breakCopyOnWrite(int64_t pageKey) {
+    addressSpace& space = _space(_asidOf(pageKey));
+    int64_t virtualPageNumber = _vpnOf(pageKey);
+    int frameNumber = space.pageTable->find(virtualPageNumber)->pageFrameNum;
+
+    // everyone else already copied the page or let go of it, so it can be written where it is
+    if (!frameSharers.count(frameNumber)) {
+        space.pageTable->find(virtualPageNumber)->copyOnWriteBit = false;
+        _policyFor(pageKey).onAccess(pageKey, true);
+        return;
+    }
+
+    copyOnWriteCopies++;
+
+    // making room for the copy can evict the shared frame itself; the page then comes back from disk
+    int copyFrame = _takeFrame(pageKey);
+    if (!space.pageTable->find(virtualPageNumber)->presentBit) {
+        _loadPage(pageKey, copyFrame);
+        return;
+    }
+
+    std::memcpy(&physicalMemory[copyFrame * PAGE_SIZE], &physicalMemory[frameNumber * PAGE_SIZE], PAGE_SIZE);
+
+    // the owner keeps its place in the policy and moves with the copy, a sharer is new to it
+    bool wasOwner = frameToVPN[frameNumber] == pageKey;
+    _unshareFrame(frameNumber, pageKey);
+
+    tlb.invalidate(_asidOf(pageKey), virtualPageNumber);
+    space.pageTable->unmap(virtualPageNumber);
+    space.pageTable->map(virtualPageNumber, copyFrame);
+    space.pageTable->find(virtualPageNumber)->copyOnWriteBit = false;
+
+    freeFrames.markUsed(copyFrame);
+    _setFrameOwner(copyFrame, pageKey);
+
+    if (wasOwner) _policyFor(pageKey).onAccess(pageKey, true);
+    else _policyFor(pageKey).onLoad(pageKey);
+}
+
+void MemoryManager:: _unshareFrame(int frameNumber, int64_t pageKey) {
+    auto sharers = frameSharers.find(frameNumber);
+    std::vector<int64_t>& others = sharers->second;
+
+    if (frameToVPN[frameNumber] == pageKey) {
+        // policies follow a frame through its owner, so one of the sharers takes over
+        int64_t newOwner = others.front();
+        others.erase(others.begin());
+        _setFrameOwner(frameNumber, newOwner);
+        _policyFor(newOwner).onLoad(newOwner);
+    } else {
+        others.erase(std::find(others.begin(), others.end(), pageKey));
+    }
+
+    // the last one left keeps its copy-on-write bit until it writes, then finds it has the frame to itself
+    if (others.empty()) frameSharers.erase(sharers);
+}
+
+void MemoryManager:: _deletePage(int64_t pageKey) {
+    addressSpace& space = _space(_asidOf(pageKey));
+    int64_t virtualPageNumber = _vpnOf(pageKey);
+    pageTableEntry* entry = space.pageTable->find(virtualPageNumber);
+
+    if (!entry)
+        throw std::logic_error("Attempted to delete an invalid page");
+
+    if (entry->hugeBit) {
+        _demote(pageKey >> HUGE_SHIFT, pageKey);
+        entry = space.pageTable->find(virtualPageNumber);
+    }
+    hugeFillers.erase(pageKey);
+
+    space.freeVPNs.markFree(virtualPageNumber);
+    tlb.invalidate(_asidOf(pageKey), virtualPageNumber);
+    _policyFor(pageKey).onRemove(pageKey);
+
+    if (entry->presentBit) {
+        int frameNumber = entry->pageFrameNum;
+
+        // a shared frame stays in memory for the processes still using it
+        if (frameSharers.count(frameNumber)) {
+            _unshareFrame(frameNumber, pageKey);
+        } else {
+            _wipeMemoryFrame(frameNumber);
+            freeFrames.markFree(frameNumber);
+            _setFrameOwner(frameNumber, -1);
+        }
+        space.residentPages--;
+        _countResident(pageKey, -1);
+    }
+
+    // a resident page can still have an older copy on disk from a previous eviction
+    _deletePageFromDisk(pageKey);
+
+    space.pageTable->erase(virtualPageNumber);
+}
+
+void MemoryManager:: _countResident(int64_t pageKey, int delta) {
+    if (HUGE_PAGES == 0) return;
+
+    int64_t region = pageKey >> HUGE_SHIFT;
+    int& count = regionResident[region];
+    count += delta;
+    if (count == 0) regionResident.erase(region);
+}
+
+void MemoryManager:: _tryPromote(int64_t region) {
+    if (HUGE_PAGES == 0 || hugeRegions.count(region)) return;
+
+    int64_t firstKey = region << HUGE_SHIFT;
+    int asid = _asidOf(firstKey);
+    int64_t firstVPN = _vpnOf(firstKey);
+    if (firstVPN + HUGE_PAGES > PAGE_COUNT) return;
+
+    auto counted = regionResident.find(region);
+    int resident = counted == regionResident.end() ? 0 : counted->second;
+    if (resident < HUGE_PAGES - hugeMaxMissing) return;
+
+    // every allocated page has to be in memory and not shared with another process; the rest will be filled in
+    addressSpace& space = _space(asid);
+    int allocated = 0;
+    for (int i = 0; i < HUGE_PAGES; i++) {
+        pageTableEntry* entry = space.pageTable->find(firstVPN + i);
+        if (!entry) continue;
+        if (entry->presentBit && frameSharers.count(entry->pageFrameNum)) return;
+        allocated++;
+    }
+    if (allocated != resident) return;
+
+    int block = _findHugeFrameBlock(region);
+    if (block == -1) {
+        hugePromotionFailures++;
+        return;
+    }
+
+    // collect the region's data and release its frames, then lay it out again across the block
+    std::vector<uint8_t> contents((size_t)HUGE_PAGES * PAGE_SIZE, 0);
+    for (int i = 0; i < HUGE_PAGES; i++) {
+        int64_t vpn = firstVPN + i;
+        pageTableEntry* entry = space.pageTable->find(vpn);
+        if (!entry) continue;
+
+        int frameNumber = entry->pageFrameNum;
+        std::memcpy(&contents[(size_t)i * PAGE_SIZE], &physicalMemory[frameNumber * PAGE_SIZE], PAGE_SIZE);
+        tlb.invalidate(asid, vpn);
+        space.pageTable->unmap(vpn);
+        freeFrames.markFree(frameNumber);
+        _setFrameOwner(frameNumber, -1);
+        _wipeMemoryFrame(frameNumber);
+    }
+
+    int firstFrame = block * HUGE_PAGES;
+    for (int i = 0; i < HUGE_PAGES; i++) {
+        int64_t vpn = firstVPN + i;
+        int frameNumber = firstFrame + i;
+
+        if (!space.pageTable->find(vpn)) {
+            space.pageTable->insert(vpn);
+            space.freeVPNs.markUsed(vpn);
+            space.residentPages++;
+            hugeFillers.insert(firstKey + i);
+            _policyFor(firstKey + i).onLoad(firstKey + i);
+        }
+
+        space.pageTable->map(vpn, frameNumber);
+        space.pageTable->find(vpn)->hugeBit = true;
+        freeFrames.markUsed(frameNumber);
+        _setFrameOwner(frameNumber, firstKey + i);
+    }
+    std::memcpy(&physicalMemory[firstFrame * PAGE_SIZE], contents.data(), contents.size());
+
+    regionResident[region] = HUGE_PAGES;
+    hugeRegions.insert(region);
+    hugePromotions++;
+}
+
+int MemoryManager:: _findHugeFrameBlock(int64_t region) {
+    int blockCount = (PHYSICAL_SIZE / PAGE_SIZE) / HUGE_PAGES;
+
+    auto usable = [&](int block) {
+        for (int frameNumber = block * HUGE_PAGES; frameNumber < (block + 1) * HUGE_PAGES; frameNumber++) {
+            int64_t owner = frameToVPN[frameNumber];
+            if (owner != -1 && (owner >> HUGE_SHIFT) != region) return false;
+        }
+        return true;
+    };
+
+    // a region allocated in order usually already sits in its own block, try those first
+    int64_t firstKey = region << HUGE_SHIFT;
+    PageTable& pageTable = *_space(_asidOf(firstKey)).pageTable;
+    for (int i = 0; i < HUGE_PAGES; i++) {
+        pageTableEntry* entry = pageTable.find(_vpnOf(firstKey) + i);
+        if (!entry) continue;
+        int block = entry->pageFrameNum / HUGE_PAGES;
+        if (block < blockCount && usable(block)) return block;
+    }
+
+    // otherwise any block will do, as long as there are enough free frames for one to exist
+    if (freeFrames.freeCount() < HUGE_PAGES - regionResident[region]) return -1;
+    for (int block = 0; block < blockCount; block++) {
+        if (usable(block)) return block;
+    }
+    return -1;
+}
+
+void MemoryManager:: _demote(int64_t region, int64_t keepKey) {
+    if (!hugeRegions.erase(region)) return;
+    hugeDemotions++;
+
+    int64_t firstKey = region << HUGE_SHIFT;
+    int asid = _asidOf(firstKey);
+    PageTable& pageTable = *_space(asid).pageTable;
+    tlb.invalidate(asid, _vpnOf(firstKey)); // the huge entry, base entries can't exist while it is huge
+
+    for (int i = 0; i < HUGE_PAGES; i++) {
+        pageTableEntry* entry = pageTable.find(_vpnOf(firstKey) + i);
+        if (entry) entry->hugeBit = false;
+    }
+
+    // give back filler pages nobody used
+    for (int i = 0; i < HUGE_PAGES; i++) {
+        int64_t pageKey = firstKey + i;
+        if (hugeFillers.erase(pageKey) && pageKey != keepKey) _deletePage(pageKey);
+    }
+}
+
 void MemoryManager:: _wipeMemoryFrame(int frameNumber){
     if (frameNumber >= (PHYSICAL_SIZE / PAGE_SIZE) || frameNumber < 0)
         throw std::out_of_range("Invalid frame number");
+    if (!simulateData) return;
 
     int baseAddress = frameNumber * PAGE_SIZE;
 
-    for (int i = 0; i < PAGE_SIZE; i++) {
-        physicalMemory[baseAddress + i] = 0;
-    }
+    std::memset(&physicalMemory[baseAddress], 0, PAGE_SIZE);
 }
 
-void MemoryManager:: _writePageToDisk(int virtualPageNumber){
-    int frameNum = pageTable[virtualPageNumber].pageFrameNum;
+void MemoryManager:: _writePageToDisk(int64_t pageKey, int frameNumber){
+    if (!simulateData) return;
 
-    for (int i = 0; i < PAGE_SIZE; i++) {
-        diskStorage[virtualPageNumber * PAGE_SIZE + i] = physicalMemory[frameNum * PAGE_SIZE + i];
-    }
+    std::vector<uint8_t>& block = diskStorage[pageKey];
+    block.resize(PAGE_SIZE);
+
+    std::memcpy(block.data(), &physicalMemory[frameNumber * PAGE_SIZE], PAGE_SIZE);
 }
 
-void MemoryManager:: _readPageFromDisk(int virtualPageNumber, int frameNumber){
-    for (int i = 0; i < PAGE_SIZE; i++) {
-        physicalMemory[frameNumber * PAGE_SIZE + i] = diskStorage[virtualPageNumber * PAGE_SIZE + i];
+void MemoryManager:: _readPageFromDisk(int64_t pageKey, int frameNumber){
+    if (!simulateData) return;
+
+    auto block = diskStorage.find(pageKey);
+    if (block == diskStorage.end()) {
+        std::memset(&physicalMemory[frameNumber * PAGE_SIZE], 0, PAGE_SIZE);
+        return;
     }
+
+    std::memcpy(&physicalMemory[frameNumber * PAGE_SIZE], block->second.data(), PAGE_SIZE);
 }
 
-void MemoryManager:: _deletePageFromDisk(int virtualPageNumber) {
-    for (int i = 0; i < PAGE_SIZE; i++) {
-        diskStorage[virtualPageNumber * PAGE_SIZE + i] = 0;
-    }
+void MemoryManager:: _deletePageFromDisk(int64_t pageKey) {
+    diskStorage.erase(pageKey);
 }
 
 // public methods
 
-int MemoryManager:: allocateAnyPage() {
+int64_t MemoryManager:: allocateAnyPage() {
     // find open page entry
-    int vpn = -1;
-    for (int i = 0; i < PAGE_COUNT; i++) {
-        if (pageTable[i].validBit != true) {
-            vpn = i;
-            break;
-        }
-    }
-    if (vpn == -1) throw std::runtime_error("No free pages available for allocation");;
+    int64_t vpn = addressSpaces.at(currentASID).freeVPNs.findFirstFree();
+    if (vpn == -1) throw std::runtime_error("No free pages available for allocation");
+    int64_t pageKey = _pageKey(currentASID, vpn);
 
     // find open frame using our map of them :P
-    int freeFrame = -1;
-    for (int i = 0; i < freeFrames.size(); i++) {
-        if (freeFrames[i]) {
-            freeFrame = i;
-            break;
-        }
-    }
+    int freeFrame = freeFrames.findFirstFree();
 
-    if (freeFrame == -1) freeFrame = _replacePage(); // page replacement here!
+    if (freeFrame == -1) freeFrame = _replacePage(pageKey); // page replacement here!
 
-    _allocatePage(vpn, freeFrame);
+    _allocatePage(pageKey, freeFrame);
+    _tryPromote(pageKey >> HUGE_SHIFT);
 
-    int virtualAddress = vpn * PAGE_SIZE;
+    int64_t virtualAddress = vpn << PAGE_SHIFT;
     return virtualAddress;
 }
 
-void MemoryManager:: writeVirtualMemory(int virtualAddress, uint8_t data) {
+int64_t MemoryManager:: allocatePage(int64_t virtualAddress) {
+    int64_t vpn = virtualAddress >> PAGE_SHIFT;
+    if (vpn >= PAGE_COUNT || vpn < 0)
+        throw std::out_of_range("Attempted to access out-of-bound virtual address");
+    if (!addressSpaces.at(currentASID).freeVPNs.isFree(vpn))
+        throw std::logic_error("Attempted to allocate a page that is already allocated");
+
+    int64_t pageKey = _pageKey(currentASID, vpn);
+    int freeFrame = _takeFrame(pageKey);
+
+    _allocatePage(pageKey, freeFrame);
+    _tryPromote(pageKey >> HUGE_SHIFT);
+
+    return vpn << PAGE_SHIFT;
+}
+
+bool MemoryManager:: isPageAllocated(int64_t virtualAddress) {
+    int64_t vpn = virtualAddress >> PAGE_SHIFT;
+    if (vpn >= PAGE_COUNT || vpn < 0) return false;
+
+    return addressSpaces.at(currentASID).pageTable->find(vpn) != nullptr;
+}
+
+void MemoryManager:: writeVirtualMemory(int64_t virtualAddress, uint8_t data) {
     int physicalAddress = _virtualToPhysicalAddress(virtualAddress, true);
     _writeMemory(physicalAddress, data);
 }
 
-uint8_t MemoryManager:: readVirtualMemory(int virtualAddress) {
+uint8_t MemoryManager:: readVirtualMemory(int64_t virtualAddress) {
     int physicalAddress = _virtualToPhysicalAddress(virtualAddress, false);
     return _readMemory(physicalAddress);
 }
 
-void MemoryManager:: deletePageTableEntry(int virtualAddress) {
-    int virtualPageNumber = virtualAddress / PAGE_SIZE;
-    if (virtualPageNumber >= PAGE_COUNT || virtualPageNumber < 0)
-        throw std::out_of_range("Attempted to access out-of-bound virtual address");
+void MemoryManager:: writeVirtualMemory(int64_t virtualAddress, const uint8_t* data, int length) {
+    _validateRange(virtualAddress, length);
 
-    pageTableEntry& entry = pageTable[virtualPageNumber];
+    // translate once per page, then copy the part of the range that falls in it
+    int copied = 0;
+    while (copied < length) {
+        int64_t address = virtualAddress + copied;
+        int chunk = PAGE_SIZE - (int)(address & (PAGE_SIZE - 1));
+        if (chunk > length - copied) chunk = length - copied;
 
-    if (!entry.validBit)
-        throw std::logic_error("Attempted to delete an invalid page");
+        int physicalAddress = _virtualToPhysicalAddress(address, true);
+        std::memcpy(&physicalMemory[physicalAddress], data + copied, chunk);
+        copied += chunk;
+    }
+}
 
-    entry.validBit = false;
+void MemoryManager:: readVirtualMemory(int64_t virtualAddress, uint8_t* buffer, int length) {
+    _validateRange(virtualAddress, length);
 
-    if (entry.presentBit) {
-        _wipeMemoryFrame(entry.pageFrameNum);
-        entry.presentBit = false;
-        freeFrames[entry.pageFrameNum] = true;
-        entry.pageFrameNum = -1;
+    int copied = 0;
+    while (copied < length) {
+        int64_t address = virtualAddress + copied;
+        int chunk = PAGE_SIZE - (int)(address & (PAGE_SIZE - 1));
+        if (chunk > length - copied) chunk = length - copied;
 
-    } else {
-        _deletePageFromDisk(virtualPageNumber);
+        int physicalAddress = _virtualToPhysicalAddress(address, false);
+        std::memcpy(buffer + copied, &physicalMemory[physicalAddress], chunk);
+        copied += chunk;
     }
+}
 
-    entry.modifyBit = false;
-    entry.referenceBit = false;
+void MemoryManager:: deletePageTableEntry(int64_t virtualAddress) {
+    int64_t virtualPageNumber = virtualAddress >> PAGE_SHIFT;
+    if (virtualPageNumber >= PAGE_COUNT || virtualPageNumber < 0)
+        throw std::out_of_range("Attempted to access out-of-bound virtual address");
+
+    _deletePage(_pageKey(currentASID, virtualPageNumber));
 }
 
-void MemoryManager:: printPageTableEntry(int virtualAddress) {
-    int virtualPageNumber = virtualAddress / PAGE_SIZE;
+void MemoryManager:: printPageTableEntry(int64_t virtualAddress) {
+    int64_t virtualPageNumber = virtualAddress >> PAGE_SHIFT;
     if (virtualPageNumber >= PAGE_COUNT || virtualPageNumber < 0)
         throw std::out_of_range("Attempted to access out-of-bound virtual address");
 
-    const pageTableEntry& entry = pageTable[virtualPageNumber];
+    // pages that were never allocated have no entry; print them as a blank one
+    static const pageTableEntry unallocated;
+    const pageTableEntry* found = addressSpaces.at(currentASID).pageTable->find(virtualPageNumber);
+    const pageTableEntry& entry = found ? *found : unallocated;
     std::cout << "Page " << virtualPageNumber << ": ";
     std::cout << "Valid = " << entry.validBit;
     std::cout << ", Present = " << entry.presentBit;
     std::cout << ", Frame = " << entry.pageFrameNum;
     std::cout << ", Referenced = " << entry.referenceBit;
     std::cout << ", Modified = " << entry.modifyBit;
+    std::cout << ", Copy-on-write = " << entry.copyOnWriteBit;
     std::cout << std::endl;
 }
+
+int MemoryManager:: createAddressSpace() {
+    // ASIDs share a page key with the VPN, so there are only so many
+    if (nextASID >= (1 << (63 - ASID_SHIFT)))
+        throw std::runtime_error("No address space IDs left");
+
+    int asid = nextASID++;
+    addressSpaces.emplace(asid, _makeAddressSpace());
+    return asid;
+}
+
+int MemoryManager:: forkAddressSpace(int asid) {
+    addressSpace& parent = _space(asid);
+
+    // huge pages are split first, so frames are shared and copied one page at a time
+    std::vector<int64_t> promoted;
+    for (int64_t region : hugeRegions) {
+        if (_asidOf(region << HUGE_SHIFT) == asid) promoted.push_back(region);
+    }
+    for (int64_t region : promoted) _demote(region, -1);
+
+    int childASID = createAddressSpace();
+    addressSpace& child = addressSpaces.at(childASID);
+    child.freeVPNs = parent.freeVPNs;
+
+    parent.pageTable->forEachPage([&](int64_t vpn, pageTableEntry& entry) {
+        int64_t parentKey = _pageKey(asid, vpn);
+        int64_t childKey = _pageKey(childASID, vpn);
+        child.pageTable->insert(vpn);
+
+        // swapped out pages are copied right away; disk is cheap here and it keeps eviction simple
+        auto block = diskStorage.find(parentKey);
+        if (block != diskStorage.end()) {
+            std::vector<uint8_t> copy = block->second;
+            diskStorage[childKey] = std::move(copy);
+        }
+
+        if (!entry.presentBit) return;
+
+        // resident pages share the parent's frame until one of them writes
+        int frameNumber = entry.pageFrameNum;
+        entry.copyOnWriteBit = true;
+        child.pageTable->map(vpn, frameNumber);
+
+        pageTableEntry* shared = child.pageTable->find(vpn);
+        shared->copyOnWriteBit = true;
+        shared->modifyBit = entry.modifyBit; // dirty against its own disk copy, same as the parent's
+        frameSharers[frameNumber].push_back(childKey);
+        child.residentPages++;
+        _countResident(childKey, 1);
+    });
+
+    forks++;
+    return childASID;
+}
+
+void MemoryManager:: switchAddressSpace(int asid) {
+    _space(asid);
+    currentASID = asid;
+}
+
+void MemoryManager:: destroyAddressSpace(int asid) {
+    addressSpace& space = _space(asid);
+    if (asid == currentASID)
+        throw std::logic_error("Cannot destroy the current address space");
+
+    std::vector<int64_t> pages;
+    space.pageTable->forEachPage([&](int64_t vpn, pageTableEntry& entry) {
+        (void)entry;
+        pages.push_back(_pageKey(asid, vpn));
+    });
+
+    // demoting a huge page deletes its fillers, so some pages may be gone by the time we get to them
+    for (int64_t pageKey : pages) {
+        if (_entry(pageKey)) _deletePage(pageKey);
+    }
+
+    tlb.flushASID(asid);
+    addressSpaces.erase(asid);
+}
+
+std::vector<int> MemoryManager:: getAddressSpaceIDs() const {
+    std::vector<int> ids;
+    for (auto& space : addressSpaces) ids.push_back(space.first);
+    return ids;
+}
+
+void MemoryManager:: setSimulateData(bool on) {
+    // disk copies kept so far would be stale once data stops moving
+    if (!on) diskStorage.clear();
+    simulateData = on;
+}
+
+void MemoryManager:: printAddressSpaceStats() {
+    std::cout << std::dec << std::noshowbase;
+    std::cout << "Address spaces: " << addressSpaces.size() << " (current ASID " << currentASID << "), "
+              << (replacementScope == ReplacementScope::GLOBAL ? "global" : "per-process") << " replacement" << std::endl;
+
+    for (auto& space : addressSpaces) {
+        const addressSpace& s = space.second;
+        std::cout << "ASID " << space.first << ": " << (PAGE_COUNT - s.freeVPNs.freeCount()) << " pages allocated, "
+                  << s.residentPages << " resident, " << s.ownedFrames << " frames owned, " << s.pageFaults << " page faults";
+        if (s.replacementPolicy) std::cout << ", policy " << s.replacementPolicy->getName();
+        std::cout << ", page table " << s.pageTable->memoryFootprint() << " bytes" << std::endl;
+    }
+
+    std::cout << "Forks: " << forks << ", Shared frames: " << frameSharers.size()
+              << ", Copy-on-write copies: " << copyOnWriteCopies << std::endl;
+}
+
+void MemoryManager:: setReplacementScope(ReplacementScope scope) {
+    if (scope == replacementScope) return;
+
+    // either way the new policies only know what is resident, not its history
+    if (scope == ReplacementScope::PER_PROCESS) {
+        replacementScope = scope;
+        for (auto& space : addressSpaces) {
+            space.second.replacementPolicy = _policyLike(replacementPolicy->getName());
+            _replayResident(*space.second.replacementPolicy, space.first);
+        }
+        return;
+    }
+
+    std::string name = getReplacementPolicyName();
+    replacementScope = scope;
+    for (auto& space : addressSpaces) space.second.replacementPolicy.reset();
+    replacementPolicy = _policyLike(name);
+    _replayResident(*replacementPolicy, -1);
+}
+
+void MemoryManager:: setReplacementPolicy(const std::string& name) {
+    std::unique_ptr<ReplacementPolicy> policy = createReplacementPolicy(name, PHYSICAL_SIZE / PAGE_SIZE);
+    if (!policy)
+        throw std::invalid_argument("Unknown page replacement policy: " + name);
+
+    if (replacementScope == ReplacementScope::GLOBAL) {
+        setReplacementPolicy(std::move(policy));
+        return;
+    }
+
+    // every process starts over with an instance of its own
+    replacementPolicy = std::move(policy);
+    for (auto& space : addressSpaces) {
+        space.second.replacementPolicy = _policyLike(name);
+        _replayResident(*space.second.replacementPolicy, space.first);
+    }
+}
+
+void MemoryManager:: setReplacementPolicy(std::unique_ptr<ReplacementPolicy> policy) {
+    if (!policy)
+        throw std::invalid_argument("Replacement policy must not be null");
+
+    // the new policy starts out knowing which pages are resident, nothing about their history
+    if (replacementScope == ReplacementScope::GLOBAL) {
+        _replayResident(*policy, -1);
+        replacementPolicy = std::move(policy);
+    } else {
+        _replayResident(*policy, currentASID);
+        addressSpaces.at(currentASID).replacementPolicy = std::move(policy);
+    }
+}
+
+std::string MemoryManager:: getReplacementPolicyName() const {
+    if (replacementScope == ReplacementScope::PER_PROCESS)
+        return addressSpaces.at(currentASID).replacementPolicy->getName();
+    return replacementPolicy->getName();
+}
+
+void MemoryManager:: printStats() {
+    std::cout << std::dec << std::noshowbase;
+    std::cout << "Replacement policy: " << getReplacementPolicyName() << std::endl;
+    std::cout << "Page faults: " << pageFaults << ", Evictions: " << pageEvictions << ", Dirty write-backs: " << diskWrites << std::endl;
+    printAddressSpaceStats();
+    printPageTableStats();
+    printHugePageStats();
+    tlb.printStats(PAGE_SIZE);
+}
+
+void MemoryManager:: configureTLB(int num_entries, int associativity, TLBReplacement policy) {
+    tlb = TLB(num_entries, associativity, policy);
+    if (HUGE_SHIFT > 0) tlb.setHugePageShift(HUGE_SHIFT);
+}
+
+void MemoryManager:: configureHugePages(int pages_per_huge_page, int max_missing) {
+    if (pages_per_huge_page < 0 || (pages_per_huge_page & (pages_per_huge_page - 1)) != 0)
+        throw std::invalid_argument("Pages per huge page must be a power of 2");
+    if (pages_per_huge_page > 1 && (max_missing < 0 || max_missing >= pages_per_huge_page))
+        throw std::invalid_argument("Missing pages allowed must be less than the huge page size");
+
+    // go back to base pages before changing the size
+    std::vector<int64_t> promoted(hugeRegions.begin(), hugeRegions.end());
+    for (int64_t region : promoted) _demote(region, -1);
+
+    HUGE_PAGES = pages_per_huge_page > 1 ? pages_per_huge_page : 0;
+    HUGE_SHIFT = 0;
+    while ((1 << HUGE_SHIFT) < HUGE_PAGES) HUGE_SHIFT++;
+    hugeMaxMissing = max_missing;
+    tlb.setHugePageShift(HUGE_SHIFT);
+
+    // shared frames count as resident for every process mapping them
+    regionResident.clear();
+    for (int64_t pageKey : frameToVPN) {
+        if (pageKey >= 0) _countResident(pageKey, 1);
+    }
+    for (auto& shared : frameSharers) {
+        for (int64_t pageKey : shared.second) _countResident(pageKey, 1);
+    }
+}
+
+void MemoryManager:: printHugePageStats() {
+    std::cout << std::dec << std::noshowbase;
+    if (HUGE_PAGES == 0) {
+        std::cout << "Huge pages: off" << std::endl;
+        return;
+    }
+
+    std::cout << "Huge pages: " << HUGE_PAGES << " x " << PAGE_SIZE << "B pages (" << (int64_t)HUGE_PAGES * PAGE_SIZE
+              << " bytes), promoted with up to " << hugeMaxMissing << " missing pages" << std::endl;
+    std::cout << "Huge mappings: " << hugeRegions.size() << " (" << (int64_t)hugeRegions.size() * HUGE_PAGES * PAGE_SIZE << " bytes)"
+              << ", Promotions: " << hugePromotions << ", Failed promotions: " << hugePromotionFailures
+              << ", Demotions: " << hugeDemotions << std::endl;
+    std::cout << "Internal fragmentation: " << hugeFillers.size() << " untouched filler pages ("
+              << getInternalFragmentation() << " bytes)" << std::endl;
+}
+
+void MemoryManager:: printTLBStats() {
+    tlb.printStats(PAGE_SIZE);
+}
+
+std::string MemoryManager:: getPageTableName() const {
+    return addressSpaces.at(currentASID).pageTable->getName();
+}
+
+void MemoryManager:: printPageTableStats() {
+    addressSpaces.at(currentASID).pageTable->printStats();
+}
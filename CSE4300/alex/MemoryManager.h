@@ -1,33 +1,110 @@
 #include <vector>
+#include <map>
 #include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include "TLB.h"
+#include "FreeBitmap.h"
+#include "FreeRanges.h"
+#include "PageTable.h"
+#include "ReplacementPolicy.h"
 
 #ifndef MEMORYMANAGER_H
 #define MEMORYMANAGER_H
 
-struct pageTableEntry {
-    bool validBit = false;
-    bool presentBit = false; // will implement page replacement later
-    bool referenceBit = false;
-    bool modifyBit = false;
-    int pageFrameNum = -1;
-};
+// whose pages a process may evict when it needs a frame: any process's (one policy sees every
+// resident page) or only its own (each address space gets its own policy instance)
+enum class ReplacementScope { GLOBAL, PER_PROCESS };
 
 class MemoryManager {
     private:
-        std::vector<pageTableEntry> pageTable;
+        // one process's view of memory: its own page table and virtual pages over the shared frames
+        struct addressSpace {
+            std::unique_ptr<PageTable> pageTable; // flat, radix or inverted, see PageTable.h
+            FreeRanges freeVPNs; // virtual pages not allocated, kept as runs so huge address spaces fit
+            std::unique_ptr<ReplacementPolicy> replacementPolicy; // only used with per-process replacement
+            int64_t residentPages = 0; // pages mapped to a frame, shared ones included
+            int ownedFrames = 0; // frames whose frameToVPN entry is one of this space's pages
+            uint64_t pageFaults = 0;
+        };
+
+        // pages are named by a key packing the ASID above the VPN, so one policy, one disk and one
+        // reverse map can cover every address space. ASID 0's keys are just its VPNs
+        static const int ASID_SHIFT = 44;
+
+        // hands policies the entry behind a page key, in any address space (asid -1) or only one
+        class pageKeyLookup : public PageLookup {
+            private:
+                MemoryManager& manager;
+                int asid;
+
+            public:
+                pageKeyLookup(MemoryManager& manager, int asid) : manager(manager), asid(asid) {}
+                pageTableEntry* find(int64_t pageKey) override;
+        };
+
+        std::map<int, addressSpace> addressSpaces; // by ASID
+        int currentASID = 0; // process whose addresses reads, writes and allocations use; also tags TLB entries
+        int nextASID = 1;
+        std::string pageTableType; // table type given to new address spaces
+        ReplacementScope replacementScope = ReplacementScope::GLOBAL;
+
         std::vector<uint8_t> physicalMemory;
-        std::vector<bool> freeFrames;
+        FreeBitmap freeFrames; // physical frames not holding a page
+        std::vector<int64_t> frameToVPN; // reverse map: page key owning each frame, -1 if free
+        std::unordered_map<int, std::vector<int64_t>> frameSharers; // other pages mapping a copy-on-write frame besides its owner
 
-        std::vector<uint8_t> diskStorage; // just going to simulate disk storage with a vector
+        std::unordered_map<int64_t, std::vector<uint8_t>> diskStorage; // pages written out, by page key. a page never written reads back as zeros
 
         int PAGE_SIZE; // 4096 bytes, 4K per page
-        int PAGE_COUNT; // 1024 entries in the page table
+        int64_t PAGE_COUNT; // 1024 pages in the virtual address space; 2^36 gives a 48-bit space with 4K pages
         int PHYSICAL_SIZE; // # of bytes of physical memory
+        int PAGE_SHIFT; // log2(PAGE_SIZE), so VPNs come from a shift instead of a division
 
-        int clockPointer = 0; // for CLOCK page replacement
+        TLB tlb; // caches recent translations in front of the page table
+        bool verbose = true; // print a line per page fault and replacement
+        bool simulateData = true; // copy page contents to and from disk; off when only paging decisions matter
 
-        // initalizes vectors. internal use
-        void _initializeMemory();
+        std::unique_ptr<ReplacementPolicy> replacementPolicy; // picks pages to evict, CLOCK by default. per-process policies are made by its name
+
+        uint64_t pageFaults = 0;
+        uint64_t pageEvictions = 0;
+        uint64_t diskWrites = 0; // dirty pages written back on eviction
+        uint64_t forks = 0;
+        uint64_t copyOnWriteCopies = 0; // shared frames copied because a process wrote to them
+
+        // huge pages: an aligned run of HUGE_PAGES virtual pages in an aligned run of frames, one TLB entry for all of it
+        int HUGE_PAGES = 0; // base pages per huge page, 0 if huge pages are off
+        int HUGE_SHIFT = 0; // log2(HUGE_PAGES)
+        int hugeMaxMissing = 0; // unallocated pages a region may have and still be promoted (they get filled in)
+        std::unordered_map<int64_t, int> regionResident; // allocated, resident pages per huge page sized region (page key >> HUGE_SHIFT)
+        std::unordered_set<int64_t> hugeRegions; // regions currently mapped as huge pages
+        std::unordered_set<int64_t> hugeFillers; // page keys allocated only to complete a huge page and not touched since
+        uint64_t hugePromotions = 0;
+        uint64_t hugePromotionFailures = 0; // region was ready but no aligned frames could be found
+        uint64_t hugeDemotions = 0;
+
+        // initalizes vectors and builds the first address space. internal use
+        void _initializeMemory(const std::string& pageTableName);
+
+        // page key of a VPN in an address space, and back. internal use
+        int64_t _pageKey(int asid, int64_t virtualPageNumber) const { return ((int64_t)asid << ASID_SHIFT) | virtualPageNumber; }
+        static int _asidOf(int64_t pageKey) { return (int)(pageKey >> ASID_SHIFT); }
+        static int64_t _vpnOf(int64_t pageKey) { return pageKey & (((int64_t)1 << ASID_SHIFT) - 1); }
+        // address space by ASID, throws if there is none. internal use
+        addressSpace& _space(int asid);
+        // entry of a page key, nullptr if not allocated. internal use
+        pageTableEntry* _entry(int64_t pageKey);
+        // policy that tracks a page key: the global one or its address space's. internal use
+        ReplacementPolicy& _policyFor(int64_t pageKey);
+        // new empty address space with the configured table type and policy. internal use
+        addressSpace _makeAddressSpace();
+        // fresh policy by name for one address space; custom ones (OPT) can't be rebuilt and fall back to Clock. internal use
+        std::unique_ptr<ReplacementPolicy> _policyLike(const std::string& name);
+        // tell a policy about every resident page it is responsible for (asid -1 for all of them). internal use
+        void _replayResident(ReplacementPolicy& policy, int asid);
 
         // write data to physical address. internal use
         void _writeMemory(int physicalAddress, uint8_t data);
@@ -35,45 +112,152 @@ class MemoryManager {
         uint8_t _readMemory(int physicalAddress);
 
         // allocate a page. internal use
-        void _allocatePage(int virtualPageNumber, int frameNumber);
+        void _allocatePage(int64_t pageKey, int frameNumber);
+        // record which page key owns a frame (-1 for none) and keep per-process frame counts. internal use
+        void _setFrameOwner(int frameNumber, int64_t pageKey);
 
         // translate virtual to physical address; handle page fault if data not present. returns physical address. internal use
-        int _virtualToPhysicalAddress(int virtualAddress, bool writeOperation);
+        int _virtualToPhysicalAddress(int64_t virtualAddress, bool writeOperation);
+        // set reference/modify bits after an access; a shared frame's owner is marked referenced too. internal use
+        void _markAccessed(int64_t pageKey, pageTableEntry* entry, bool writeOperation);
+        // check that every page in [virtualAddress, virtualAddress + length) is in bounds and valid. internal use
+        void _validateRange(int64_t virtualAddress, int length);
 
         // handle page fault by replacing and loading pages. internal use
-        void _handlePageFault(int virtualPageNumber);
-        // eject page frames using a CLOCK algorithm. returns new frame number. internal use
-        int _replacePage();
+        void _handlePageFault(int64_t pageKey);
+        // read a page from disk into a frame and make it resident. internal use
+        void _loadPage(int64_t pageKey, int frameNumber);
+        // free frame for incomingKey, evicting a page if there is none. internal use
+        int _takeFrame(int64_t incomingKey);
+        // eject a page frame chosen by the replacement policy to make room for incomingKey. returns new frame number. internal use
+        int _replacePage(int64_t incomingKey);
+
+        // give a writing process its own copy of a copy-on-write page. internal use
+        void _breakCopyOnWrite(int64_t pageKey);
+        // take a page off a shared frame, handing ownership to another sharer if needed. internal use
+        void _unshareFrame(int frameNumber, int64_t pageKey);
+        // delete a page by key: free its frame (unless still shared), disk copy and entry. internal use
+        void _deletePage(int64_t pageKey);
+
+        // track a page becoming resident (+1) or leaving memory (-1) in its region. internal use
+        void _countResident(int64_t pageKey, int delta);
+        // map a region as a huge page if it is populated enough and aligned frames can be found. internal use
+        void _tryPromote(int64_t region);
+        // aligned block of frames that only holds free frames or pages of region, -1 if none. internal use
+        int _findHugeFrameBlock(int64_t region);
+        // split a huge page back into base pages and delete untouched filler pages (except keepKey). internal use
+        void _demote(int64_t region, int64_t keepKey);
 
         // set all data in a frame to 0. internal use
         void _wipeMemoryFrame(int frameNumber);
 
         // write pages frame to "disk". internal use
-        void _writePageToDisk(int virtualPageNumber);
+        void _writePageToDisk(int64_t pageKey, int frameNumber);
         // read pages frame from "disk" back to memory. internal use
-        void _readPageFromDisk(int virtualPageNumber, int frameNumber);
+        void _readPageFromDisk(int64_t pageKey, int frameNumber);
         // erase pages data from disk. internal use
-        void _deletePageFromDisk(int virtualPageNumber);
+        void _deletePageFromDisk(int64_t pageKey);
 
     public:
         // initalize memory manager with default parameters (4096 byte page size, 1024 PTEs, 1024 physical memory frames)
         MemoryManager();
-        // initalize memory manager with custom parameters: Page Size (bytes), Page Table Entries, Physical Memory Frames
-        MemoryManager(int page_size, int num_pages, int num_frames);
+        // initalize memory manager with custom parameters: Page Size (bytes), Virtual Pages, Physical Memory Frames,
+        // and page table type (see pageTableNames(); flat tables are limited to 2^24 pages)
+        MemoryManager(int page_size, int64_t num_pages, int num_frames, const std::string& page_table = "flat");
+
+        // reads, writes, allocations and deletions below work on the current address space (ASID 0 to start with)
+
+        // new, empty address space over the same physical frames. returns its ASID
+        int createAddressSpace();
+        // copy an address space, fork() style: the child shares every resident frame copy-on-write and
+        // gets its own copy of pages on disk. huge pages of the parent are split first. returns the child's ASID
+        int forkAddressSpace(int asid);
+        // make an address space current. TLB entries are tagged, so nothing is flushed
+        void switchAddressSpace(int asid);
+        // delete every page of an address space and drop it. the current one can't be destroyed
+        void destroyAddressSpace(int asid);
+        int getCurrentASID() const { return currentASID; }
+        // ASIDs of every address space, in order
+        std::vector<int> getAddressSpaceIDs() const;
+        // print pages, resident pages, frames owned and faults per address space to std::cout
+        void printAddressSpaceStats();
+
+        // evict from any process (one global policy) or only from the faulting process (a policy per
+        // address space, replaying what is resident). a process with no frames of its own takes from the largest
+        void setReplacementScope(ReplacementScope scope);
+        ReplacementScope getReplacementScope() const { return replacementScope; }
+        uint64_t getCopyOnWriteCopies() const { return copyOnWriteCopies; }
 
         // allocate a page in the table. will replace existing page if no free frames. returns virtual memory address
-        int allocateAnyPage();
+        int64_t allocateAnyPage();
+        // allocate the page holding a given virtual address, e.g. when replaying a trace. throws if it is already allocated.
+        // returns the page's virtual address
+        int64_t allocatePage(int64_t virtualAddress);
+        // whether the page holding a virtual address is allocated (false when out of bounds)
+        bool isPageAllocated(int64_t virtualAddress);
 
         // write to a virtual memory address
-        void writeVirtualMemory(int virtualAddress, uint8_t data);
+        void writeVirtualMemory(int64_t virtualAddress, uint8_t data);
         // read from a virtual memory address. returns data (uint8_t)
-        uint8_t readVirtualMemory(int virtualAddress);
+        uint8_t readVirtualMemory(int64_t virtualAddress);
+
+        // write length bytes starting at a virtual memory address; may cross page boundaries
+        void writeVirtualMemory(int64_t virtualAddress, const uint8_t* data, int length);
+        // read length bytes starting at a virtual memory address into buffer; may cross page boundaries
+        void readVirtualMemory(int64_t virtualAddress, uint8_t* buffer, int length);
 
         // delete a page table entry and free its memory/disk usage
-        void deletePageTableEntry(int virtualAddress);
+        void deletePageTableEntry(int64_t virtualAddress);
 
         // print stats for a page table entry at an address to std::cout
-        void printPageTableEntry(int virtualAddress);
+        void printPageTableEntry(int64_t virtualAddress);
+
+        // name of the page table type in use
+        std::string getPageTableName() const;
+        // walk counters and table footprint of the current address space
+        const PageTable& getPageTable() const { return *addressSpaces.at(currentASID).pageTable; }
+        // print the current address space's page table type, walk cost and memory footprint to std::cout
+        void printPageTableStats();
+
+        // switch page replacement policy by name (see replacementPolicyNames()). pages already in memory are handed to the new policy
+        // (with per-process replacement, every address space gets a fresh instance)
+        void setReplacementPolicy(const std::string& name);
+        // switch to a custom policy, e.g. OptimalPolicy built from a trace. with per-process replacement it goes to the current address space
+        void setReplacementPolicy(std::unique_ptr<ReplacementPolicy> policy);
+        // name of the active replacement policy (the current address space's, with per-process replacement)
+        std::string getReplacementPolicyName() const;
+
+        int getPageSize() const { return PAGE_SIZE; }
+        int64_t getPageCount() const { return PAGE_COUNT; }
+        int getFrameCount() const { return PHYSICAL_SIZE / PAGE_SIZE; }
+        // turn the per-fault messages off for batch runs
+        void setVerbose(bool on) { verbose = on; }
+        // with data off, evictions and faults skip copying page contents to and from disk, so a trace replay
+        // only pays for the paging decisions. counters stay the same, but data read back is not what was written
+        void setSimulateData(bool on);
+
+        uint64_t getPageFaults() const { return pageFaults; }
+        uint64_t getPageEvictions() const { return pageEvictions; }
+        uint64_t getDiskWrites() const { return diskWrites; }
+        // print page fault/eviction counters, address space, page table and TLB statistics to std::cout
+        void printStats();
+
+        // turn on huge pages of pages_per_huge_page base pages (power of 2; 0 turns them off). a region is promoted
+        // once it is resident with at most max_missing pages unallocated; those are allocated to fill it
+        void configureHugePages(int pages_per_huge_page, int max_missing = 0);
+        uint64_t getHugePromotions() const { return hugePromotions; }
+        uint64_t getHugeDemotions() const { return hugeDemotions; }
+        // bytes of memory in filler pages nobody has touched
+        int64_t getInternalFragmentation() const { return (int64_t)hugeFillers.size() * PAGE_SIZE; }
+        // print huge page counts, promotions/demotions and internal fragmentation to std::cout
+        void printHugePageStats();
+
+        // replace the TLB with a new configuration (drops all cached translations and counters)
+        void configureTLB(int num_entries, int associativity, TLBReplacement policy = TLBReplacement::LRU);
+        // TLB counters, for reporting hit rate and translation cost
+        const TLB& getTLB() const { return tlb; }
+        // print TLB configuration and statistics to std::cout
+        void printTLBStats();
 };
 
 #endif
@@ -1,6 +1,8 @@
 #include <iostream>
 #include <string>
+#include <algorithm>
 #include <limits>
+#include <cstdint>
 #include "MemoryManager.h"
 
 MemoryManager mm;
@@ -8,10 +10,10 @@ MemoryManager mm;
 bool running = true;
 
 std::string listOptions() {
-    return "1. Allocate a new page\n2. Delete a page at an address\n3. Write to an address\n4. Read from an address\n5. Print information about the page at an address\n6. [ADVANCED] Reinitialize MemoryManager\n7. Exit\n";
+    return "1. Allocate a new page\n2. Delete a page at an address\n3. Write to an address\n4. Read from an address\n5. Print information about the page at an address\n6. [ADVANCED] Reinitialize MemoryManager\n7. Print memory statistics\n8. Choose page replacement policy\n9. Manage processes (create, fork, switch, destroy)\n10. Exit\n";
 }
 
-int hexStringToInt(std::string string) {
+int64_t hexStringToInt(std::string string) {
     // validate that string is valid hex
     if (string.compare(0, 2, "0x") == 0 || string.compare(0, 2, "0X") == 0) {
         string.erase(0, 2);
@@ -20,9 +22,9 @@ int hexStringToInt(std::string string) {
         if (!isxdigit(character)) return -1;
     }
 
-    int integer;
+    int64_t integer;
     try {
-        integer = std::stoi(string, nullptr, 16);
+        integer = std::stoll(string, nullptr, 16);
     } catch (const std::exception& e) {
         std::cerr << "Caught an exception: " << e.what() << " (probably too big of a number)" << std::endl;
         return -1;
@@ -32,7 +34,7 @@ int hexStringToInt(std::string string) {
 }
 
 void allocateAPage() {
-    int newPage;
+    int64_t newPage;
     try {
         newPage = mm.allocateAnyPage();
     }
@@ -48,7 +50,7 @@ void allocateAPage() {
 
 void deleteAPage() {
     std::string input;
-    int address;
+    int64_t address;
 
     std::cout << "Enter address of page you would like deleted (enter -1 to return to menu): ";
     std::cin >> input; std::cout << std::endl;
@@ -68,7 +70,7 @@ void deleteAPage() {
 
 void writeToAnAddress() {
     std::string input;
-    int address;
+    int64_t address;
     int data;
 
     std::cout << "Enter address you would like to write to (enter -1 to return to menu): ";
@@ -82,7 +84,7 @@ void writeToAnAddress() {
     std::cin >> input; std::cout << std::endl;
     std::string zeroBaseData = "";
     if (input.compare(0, 2, "0x") == 0 || input.compare(0, 2, "0X") == 0) {
-        data = hexStringToInt(input);
+        data = (int)hexStringToInt(input);
         std::cout << std::hex << std::showbase;
         if (data == 0) zeroBaseData = "0x";
     } else {
@@ -107,7 +109,7 @@ void writeToAnAddress() {
 
 void readFromAnAddress() {
     std::string input;
-    int address;
+    int64_t address;
     int data;
 
     std::cout << "Enter address you would like to write to (enter -1 to return to menu): ";
@@ -133,7 +135,7 @@ void readFromAnAddress() {
 
 void printPageInfo() {
     std::string input;
-    int address;
+    int64_t address;
 
     std::cout << "Enter address you would like to print page info of (enter -1 to return to menu): ";
     std::cin >> input; std::cout << std::endl;
@@ -157,8 +159,12 @@ void printPageInfo() {
 void reinitializeMemory() {
     std::string input;
     int page_size = 4096;
-    int num_pages = 1024;
+    int64_t num_pages = 1024;
     int num_frames = 1024;
+    std::string page_table = "flat";
+    int tlb_entries = 64;
+    int tlb_ways = 4;
+    int huge_pages = 0;
 
 
     std::cout << "WARNING! This will reset all data entered. Enter 1 to continue, -1 to return: ";
@@ -177,17 +183,119 @@ void reinitializeMemory() {
     std::cin >> input; std::cout << std::endl;
     try {page_size = std::stoi(input, nullptr, 10);} catch (...) {page_size = -1;} if(page_size < 0) return;
 
-    std::cout << "Enter number of pages (enter -1 to return to menu): ";
+    std::cout << "Enter number of pages (e.g. 68719476736 for a 48-bit space with 4K pages) (enter -1 to return to menu): ";
     std::cin >> input; std::cout << std::endl;
-    try {num_pages = std::stoi(input, nullptr, 10);} catch (...) {num_pages = -1;} if(num_pages < 0) return;
+    try {num_pages = std::stoll(input, nullptr, 10);} catch (...) {num_pages = -1;} if(num_pages < 0) return;
 
     std::cout << "Enter number of physical memory frames (enter -1 to return to menu): ";
     std::cin >> input; std::cout << std::endl;
     try {num_frames = std::stoi(input, nullptr, 10);} catch (...) {num_frames = -1;} if(num_frames < 0) return;
 
-    mm = MemoryManager(page_size, num_pages, num_frames);
+    std::cout << "Enter page table type (";
+    for (const auto& name : pageTableNames()) std::cout << (name == "flat" ? "" : ", ") << name;
+    std::cout << ") (enter -1 to return to menu): ";
+    std::cin >> input; std::cout << std::endl;
+    if (input == "-1") return;
+    page_table = input;
+
+    std::cout << "Enter number of TLB entries (enter -1 to return to menu): ";
+    std::cin >> input; std::cout << std::endl;
+    try {tlb_entries = std::stoi(input, nullptr, 10);} catch (...) {tlb_entries = -1;} if(tlb_entries < 0) return;
+
+    std::cout << "Enter TLB associativity (ways per set, must divide the entry count) (enter -1 to return to menu): ";
+    std::cin >> input; std::cout << std::endl;
+    try {tlb_ways = std::stoi(input, nullptr, 10);} catch (...) {tlb_ways = -1;} if(tlb_ways < 0) return;
+
+    std::cout << "Enter pages per huge page (power of 2, e.g. 512 for 2MB huge pages with 4K pages, 0 for off) (enter -1 to return to menu): ";
+    std::cin >> input; std::cout << std::endl;
+    try {huge_pages = std::stoi(input, nullptr, 10);} catch (...) {huge_pages = -1;} if(huge_pages < 0) return;
+
+    try {
+        MemoryManager replacement(page_size, num_pages, num_frames, page_table);
+        replacement.configureTLB(tlb_entries, tlb_ways);
+        replacement.configureHugePages(huge_pages);
+        replacement.setReplacementScope(mm.getReplacementScope());
+        replacement.setReplacementPolicy(mm.getReplacementPolicyName());
+        mm = std::move(replacement);
+    } catch (const std::exception& e) {
+        std::cerr << "Caught an exception: " << e.what() << std::endl;
+        return;
+    }
+
+    std::cout << "MemoryManager reinitialized with:\n" << num_pages << " " << page_size << "B pages\nNumber of physical memory frames: " << num_frames << "\nPage table: " << mm.getPageTableName() << "\nTLB: " << tlb_entries << " entries, " << tlb_ways << "-way\nPages per huge page: " << huge_pages << std::endl;
+}
+
+void printStatistics() {
+    mm.printStats();
+}
+
+void chooseReplacementPolicy() {
+    std::string input;
+
+    std::cout << "Current page replacement policy: " << mm.getReplacementPolicyName() << std::endl;
+    std::cout << "Available policies:";
+    for (const auto& name : replacementPolicyNames()) std::cout << " " << name;
+    std::cout << std::endl;
+
+    std::cout << "Enter policy name (enter -1 to return to menu): ";
+    std::cin >> input; std::cout << std::endl;
+    if (input == "-1") return;
+
+    std::string scope;
+    std::cout << "Evict from any process (global) or only the faulting one (local)? (enter -1 to return to menu): ";
+    std::cin >> scope; std::cout << std::endl;
+    if (scope == "-1") return;
+    if (scope != "global" && scope != "local") {std::cout << "Please enter global or local!" << std::endl; return;}
 
-    std::cout << "MemoryManager reinitialized with:\n" << num_pages << " " << page_size << "B pages\nNumber of physical memory frames: " << num_frames << std::endl;
+    try {
+        mm.setReplacementScope(scope == "global" ? ReplacementScope::GLOBAL : ReplacementScope::PER_PROCESS);
+        mm.setReplacementPolicy(input);
+    } catch (const std::exception& e) {
+        std::cerr << "Caught an exception: " << e.what() << std::endl;
+        return;
+    }
+
+    std::cout << "Page replacement policy set to " << mm.getReplacementPolicyName() << " (" << scope << ")!" << std::endl;
+}
+
+void manageProcesses() {
+    std::string input;
+
+    std::cout << "Current process: ASID " << std::dec << mm.getCurrentASID() << ", all processes:";
+    for (int asid : mm.getAddressSpaceIDs()) std::cout << " " << asid;
+    std::cout << std::endl;
+
+    std::cout << "Enter c to create a process, f to fork the current one, s to switch, d to destroy (enter -1 to return to menu): ";
+    std::cin >> input; std::cout << std::endl;
+    if (input == "-1") return;
+
+    try {
+        if (input == "c") {
+            std::cout << "Created process with ASID " << mm.createAddressSpace() << std::endl;
+        } else if (input == "f") {
+            std::cout << "Forked process " << mm.getCurrentASID() << " into ASID " << mm.forkAddressSpace(mm.getCurrentASID())
+                      << " (pages are shared copy-on-write)" << std::endl;
+        } else if (input == "s" || input == "d") {
+            std::string target;
+            std::cout << "Enter ASID (enter -1 to return to menu): ";
+            std::cin >> target; std::cout << std::endl;
+            int asid;
+            try {asid = std::stoi(target, nullptr, 10);} catch (...) {asid = -1;} if (asid < 0) return;
+
+            if (input == "s") {
+                mm.switchAddressSpace(asid);
+                std::cout << "Switched to process " << asid << "!" << std::endl;
+            } else {
+                mm.destroyAddressSpace(asid);
+                std::cout << "Process " << asid << " destroyed!" << std::endl;
+            }
+        } else {
+            std::cout << "Please pick c, f, s or d!" << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Caught an exception: " << e.what() << std::endl;
+        return;
+    }
 }
 
 void exitProgram() {
@@ -217,10 +325,19 @@ void handleOptions(int choice) {
             reinitializeMemory();
             break;
         case 7:
+            printStatistics();
+            break;
+        case 8:
+            chooseReplacementPolicy();
+            break;
+        case 9:
+            manageProcesses();
+            break;
+        case 10:
             exitProgram();
             break;
     }
-    if (choice != 7) {
+    if (choice != 10) {
         std::cout << "Press enter to continue...";
         while (std::cin.get() != '\n');
         while (std::cin.get() != '\n');
@@ -241,9 +358,9 @@ int main() {
         std::cin >> selection;
         std::cout << std::endl;
 
-        if (selection.length() == 1 && isdigit(selection[0])) {
-            choice = selection[0] - '0';
-            if (choice >= 1 && choice <= 7) {
+        if (!selection.empty() && selection.length() <= 2 && std::all_of(selection.begin(), selection.end(), ::isdigit)) {
+            choice = std::stoi(selection);
+            if (choice >= 1 && choice <= 10) {
                 handleOptions(choice);
                 continue;
             }
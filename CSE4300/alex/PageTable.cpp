@@ -0,0 +1,350 @@
+#include <iostream>
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+#include "PageTable.h"
+
+// PageTable
+
+void PageTable:: map(int64_t virtualPageNumber, int frameNumber) {
+    pageTableEntry* entry = find(virtualPageNumber);
+    if (!entry) throw std::logic_error("Attempted to map a page that is not allocated");
+
+    entry->presentBit = true;
+    entry->pageFrameNum = frameNumber;
+}
+
+void PageTable:: unmap(int64_t virtualPageNumber) {
+    pageTableEntry* entry = find(virtualPageNumber);
+    if (!entry) throw std::logic_error("Attempted to unmap a page that is not allocated");
+
+    entry->presentBit = false;
+    entry->pageFrameNum = -1;
+}
+
+double PageTable:: averageWalkReferences() const {
+    if (walks == 0) return 0.0;
+    return (double)walkReferences / walks;
+}
+
+void PageTable:: printStats() const {
+    std::cout << std::dec << std::noshowbase;
+    std::cout << "Page table: " << getName() << ", " << memoryFootprint() << " bytes" << std::endl;
+    std::cout << "Walks: " << walks << ", Memory references: " << walkReferences
+              << " (" << averageWalkReferences() << " per walk)" << std::endl;
+}
+
+// Flat
+
+FlatPageTable:: FlatPageTable(int64_t numPages) {
+    // 2^24 entries is already 128MB of table; bigger spaces need a sparse table
+    if (numPages < 0 || numPages > ((int64_t)1 << 24))
+        throw std::invalid_argument("Flat page table supports up to 2^24 pages, use a radix or inverted table");
+
+    entries.resize(numPages);
+}
+
+pageTableEntry* FlatPageTable:: find(int64_t virtualPageNumber) {
+    pageTableEntry& entry = entries[virtualPageNumber];
+    return entry.validBit ? &entry : nullptr;
+}
+
+pageTableEntry* FlatPageTable:: walk(int64_t virtualPageNumber) {
+    walks++;
+    walkReferences++;
+    return find(virtualPageNumber);
+}
+
+pageTableEntry& FlatPageTable:: insert(int64_t virtualPageNumber) {
+    pageTableEntry& entry = entries[virtualPageNumber];
+    entry = pageTableEntry();
+    entry.validBit = true;
+    return entry;
+}
+
+void FlatPageTable:: erase(int64_t virtualPageNumber) {
+    entries[virtualPageNumber] = pageTableEntry();
+}
+
+void FlatPageTable:: forEachPage(const std::function<void(int64_t, pageTableEntry&)>& visit) {
+    for (size_t vpn = 0; vpn < entries.size(); vpn++) {
+        if (entries[vpn].validBit) visit((int64_t)vpn, entries[vpn]);
+    }
+}
+
+uint64_t FlatPageTable:: memoryFootprint() const {
+    return entries.size() * sizeof(pageTableEntry);
+}
+
+// Radix
+
+RadixPageTable:: RadixPageTable(int64_t numPages, int levels)
+: LEVELS(levels) {
+    if (levels < 1) throw std::invalid_argument("Radix page table needs at least one level");
+    if (numPages < 0) throw std::invalid_argument("Page count must not be negative");
+
+    int vpnBits = 0;
+    while (((int64_t)1 << vpnBits) < numPages) vpnBits++;
+
+    // split the VPN as evenly as possible, leftover bits go to the top levels
+    levelBits.assign(LEVELS, vpnBits / LEVELS);
+    for (int level = 0; level < vpnBits % LEVELS; level++) levelBits[level]++;
+
+    levelShift.assign(LEVELS, 0);
+    for (int level = LEVELS - 2; level >= 0; level--)
+        levelShift[level] = levelShift[level + 1] + levelBits[level + 1];
+
+    root = _makeNode(0);
+}
+
+int RadixPageTable:: _index(int64_t virtualPageNumber, int level) const {
+    return (int)((virtualPageNumber >> levelShift[level]) & (((int64_t)1 << levelBits[level]) - 1));
+}
+
+uint64_t RadixPageTable:: _nodeBytes(int level) const {
+    uint64_t slots = (uint64_t)1 << levelBits[level];
+    return slots * (level == LEVELS - 1 ? sizeof(pageTableEntry) : sizeof(std::unique_ptr<Node>));
+}
+
+std::unique_ptr<RadixPageTable::Node> RadixPageTable:: _makeNode(int level) {
+    auto node = std::make_unique<Node>();
+    size_t slots = (size_t)1 << levelBits[level];
+    if (level == LEVELS - 1) node->entries.resize(slots);
+    else node->children.resize(slots);
+
+    nodeBytes += _nodeBytes(level);
+    nodeCount++;
+    return node;
+}
+
+std::string RadixPageTable:: getName() const {
+    return "radix" + std::to_string(LEVELS);
+}
+
+pageTableEntry* RadixPageTable:: find(int64_t virtualPageNumber) {
+    Node* node = root.get();
+    for (int level = 0; level < LEVELS - 1; level++) {
+        node = node->children[_index(virtualPageNumber, level)].get();
+        if (!node) return nullptr;
+    }
+
+    pageTableEntry& entry = node->entries[_index(virtualPageNumber, LEVELS - 1)];
+    return entry.validBit ? &entry : nullptr;
+}
+
+pageTableEntry* RadixPageTable:: walk(int64_t virtualPageNumber) {
+    walks++;
+
+    // one reference per level, stopping early at a missing node like a hardware walker would
+    Node* node = root.get();
+    for (int level = 0; level < LEVELS - 1; level++) {
+        walkReferences++;
+        node = node->children[_index(virtualPageNumber, level)].get();
+        if (!node) return nullptr;
+    }
+
+    walkReferences++;
+    pageTableEntry& entry = node->entries[_index(virtualPageNumber, LEVELS - 1)];
+    return entry.validBit ? &entry : nullptr;
+}
+
+pageTableEntry& RadixPageTable:: insert(int64_t virtualPageNumber) {
+    Node* node = root.get();
+    for (int level = 0; level < LEVELS - 1; level++) {
+        std::unique_ptr<Node>& child = node->children[_index(virtualPageNumber, level)];
+        if (!child) {
+            child = _makeNode(level + 1);
+            node->used++;
+        }
+        node = child.get();
+    }
+
+    pageTableEntry& entry = node->entries[_index(virtualPageNumber, LEVELS - 1)];
+    if (!entry.validBit) node->used++;
+    entry = pageTableEntry();
+    entry.validBit = true;
+    return entry;
+}
+
+void RadixPageTable:: erase(int64_t virtualPageNumber) {
+    std::vector<Node*> path = {root.get()};
+    for (int level = 0; level < LEVELS - 1; level++) {
+        Node* child = path.back()->children[_index(virtualPageNumber, level)].get();
+        if (!child) return;
+        path.push_back(child);
+    }
+
+    pageTableEntry& entry = path.back()->entries[_index(virtualPageNumber, LEVELS - 1)];
+    if (!entry.validBit) return;
+    entry = pageTableEntry();
+    path.back()->used--;
+
+    // free nodes left empty, bottom up (the root always stays)
+    for (int level = LEVELS - 1; level > 0 && path[level]->used == 0; level--) {
+        path[level - 1]->children[_index(virtualPageNumber, level - 1)].reset();
+        path[level - 1]->used--;
+        nodeBytes -= _nodeBytes(level);
+        nodeCount--;
+    }
+}
+
+void RadixPageTable:: _forEach(Node* node, int level, int64_t base, const std::function<void(int64_t, pageTableEntry&)>& visit) {
+    size_t slots = (size_t)1 << levelBits[level];
+    for (size_t index = 0; index < slots; index++) {
+        int64_t prefix = base | ((int64_t)index << levelShift[level]);
+        if (level == LEVELS - 1) {
+            if (node->entries[index].validBit) visit(prefix, node->entries[index]);
+        } else if (node->children[index]) {
+            _forEach(node->children[index].get(), level + 1, prefix, visit);
+        }
+    }
+}
+
+void RadixPageTable:: forEachPage(const std::function<void(int64_t, pageTableEntry&)>& visit) {
+    // only allocated nodes are visited, so this follows the table size, not the address space
+    _forEach(root.get(), 0, 0, visit);
+}
+
+uint64_t RadixPageTable:: memoryFootprint() const {
+    return nodeBytes;
+}
+
+void RadixPageTable:: printStats() const {
+    PageTable::printStats();
+    std::cout << "Index bits per level:";
+    for (int bits : levelBits) std::cout << " " << bits;
+    std::cout << ", Nodes allocated: " << nodeCount << std::endl;
+}
+
+// Inverted
+
+InvertedPageTable:: InvertedPageTable(int numFrames) {
+    if (numFrames < 0) throw std::invalid_argument("Frame count must not be negative");
+
+    frames.resize(numFrames);
+
+    // a power of two at least as large as the frame count keeps chains short
+    size_t anchorCount = 1;
+    while (anchorCount < (size_t)numFrames) anchorCount <<= 1;
+    anchors.assign(anchorCount, -1);
+}
+
+size_t InvertedPageTable:: _hash(int64_t virtualPageNumber) const {
+    // multiplicative hash so neighbouring VPNs spread across the anchors
+    uint64_t mixed = (uint64_t)virtualPageNumber * 0x9E3779B97F4A7C15ull;
+    return (mixed >> 32) & (anchors.size() - 1);
+}
+
+int InvertedPageTable:: _lookup(int64_t virtualPageNumber, bool counted) {
+    if (counted) {
+        walks++;
+        walkReferences++; // the anchor
+    }
+
+    for (int frame = anchors[_hash(virtualPageNumber)]; frame != -1; frame = frames[frame].next) {
+        if (counted) walkReferences++;
+        if (frames[frame].virtualPageNumber == virtualPageNumber) return frame;
+    }
+    return -1;
+}
+
+void InvertedPageTable:: _unlink(int frameNumber) {
+    int* link = &anchors[_hash(frames[frameNumber].virtualPageNumber)];
+    while (*link != frameNumber) link = &frames[*link].next;
+    *link = frames[frameNumber].next;
+
+    frames[frameNumber] = invertedEntry();
+}
+
+pageTableEntry* InvertedPageTable:: find(int64_t virtualPageNumber) {
+    int frame = _lookup(virtualPageNumber, false);
+    if (frame != -1) return &frames[frame].entry;
+
+    auto found = notResident.find(virtualPageNumber);
+    return found == notResident.end() ? nullptr : &found->second;
+}
+
+pageTableEntry* InvertedPageTable:: walk(int64_t virtualPageNumber) {
+    int frame = _lookup(virtualPageNumber, true);
+    return frame == -1 ? nullptr : &frames[frame].entry;
+}
+
+pageTableEntry& InvertedPageTable:: insert(int64_t virtualPageNumber) {
+    pageTableEntry& entry = notResident[virtualPageNumber];
+    entry = pageTableEntry();
+    entry.validBit = true;
+    return entry;
+}
+
+void InvertedPageTable:: erase(int64_t virtualPageNumber) {
+    int frame = _lookup(virtualPageNumber, false);
+    if (frame != -1) _unlink(frame);
+    else notResident.erase(virtualPageNumber);
+}
+
+void InvertedPageTable:: map(int64_t virtualPageNumber, int frameNumber) {
+    auto found = notResident.find(virtualPageNumber);
+    if (found == notResident.end())
+        throw std::logic_error("Attempted to map a page that is not allocated or already mapped");
+    if (frames[frameNumber].virtualPageNumber != -1)
+        throw std::logic_error("Attempted to map a page into a frame that is in use");
+
+    // the entry moves into the frame's slot and joins the front of its hash chain
+    invertedEntry& slot = frames[frameNumber];
+    slot.virtualPageNumber = virtualPageNumber;
+    slot.entry = found->second;
+    slot.entry.presentBit = true;
+    slot.entry.pageFrameNum = frameNumber;
+    notResident.erase(found);
+
+    size_t anchor = _hash(virtualPageNumber);
+    slot.next = anchors[anchor];
+    anchors[anchor] = frameNumber;
+}
+
+void InvertedPageTable:: unmap(int64_t virtualPageNumber) {
+    int frame = _lookup(virtualPageNumber, false);
+    if (frame == -1)
+        throw std::logic_error("Attempted to unmap a page that is not in memory");
+
+    pageTableEntry entry = frames[frame].entry;
+    entry.presentBit = false;
+    entry.pageFrameNum = -1;
+    _unlink(frame);
+    notResident[virtualPageNumber] = entry;
+}
+
+void InvertedPageTable:: forEachPage(const std::function<void(int64_t, pageTableEntry&)>& visit) {
+    for (invertedEntry& slot : frames) {
+        if (slot.virtualPageNumber != -1) visit(slot.virtualPageNumber, slot.entry);
+    }
+    for (auto& page : notResident) visit(page.first, page.second);
+}
+
+uint64_t InvertedPageTable:: memoryFootprint() const {
+    return frames.size() * sizeof(invertedEntry) + anchors.size() * sizeof(int);
+}
+
+void InvertedPageTable:: printStats() const {
+    PageTable::printStats();
+    std::cout << "Frame entries: " << frames.size() << ", Anchor slots: " << anchors.size()
+              << ", Allocated pages not in memory: " << notResident.size() << std::endl;
+}
+
+// factory
+
+std::vector<std::string> pageTableNames() {
+    return {"flat", "radix2", "radix3", "radix4", "inverted"};
+}
+
+std::unique_ptr<PageTable> createPageTable(const std::string& name, int64_t numPages, int numFrames) {
+    std::string key = name;
+    std::transform(key.begin(), key.end(), key.begin(), [](unsigned char c) { return std::tolower(c); });
+
+    if (key == "flat") return std::make_unique<FlatPageTable>(numPages);
+    if (key == "radix2") return std::make_unique<RadixPageTable>(numPages, 2);
+    if (key == "radix3") return std::make_unique<RadixPageTable>(numPages, 3);
+    if (key == "radix4") return std::make_unique<RadixPageTable>(numPages, 4);
+    if (key == "inverted") return std::make_unique<InvertedPageTable>(numFrames);
+    return nullptr;
+}
@@ -0,0 +1,177 @@
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+
+#ifndef PAGETABLE_H
+#define PAGETABLE_H
+
+struct pageTableEntry {
+    bool validBit = false;
+    bool presentBit = false; // will implement page replacement later
+    bool referenceBit = false;
+    bool modifyBit = false;
+    bool hugeBit = false; // part of a huge page mapping
+    bool copyOnWriteBit = false; // frame may be shared after a fork, copy it before writing
+    int pageFrameNum = -1;
+};
+
+// Anything that can hand out the entry behind a page number. Replacement policies look pages up
+// through this, so one policy can cover a single page table or every address space at once.
+class PageLookup {
+    public:
+        virtual ~PageLookup() = default;
+
+        // entry of an allocated page, nullptr if there is none
+        virtual pageTableEntry* find(int64_t virtualPageNumber) = 0;
+};
+
+// Maps virtual page numbers to page table entries. MemoryManager asks for a translation with
+// walk(), which counts the memory references a hardware walker would make, and uses find() for
+// its own bookkeeping (not counted). Entries may move when pages are inserted, erased, mapped or
+// unmapped, so pointers from find()/walk() must not be kept across those calls.
+class PageTable : public PageLookup {
+    protected:
+        uint64_t walks = 0;
+        uint64_t walkReferences = 0; // table entries read by walks
+
+    public:
+        virtual ~PageTable() = default;
+
+        // name of the table type, for printing
+        virtual std::string getName() const = 0;
+
+        // entry of an allocated page, nullptr if the page is not allocated
+        pageTableEntry* find(int64_t virtualPageNumber) override = 0;
+        // translation walk, counted. nullptr if the walk finds nothing (inverted tables only hold resident pages)
+        virtual pageTableEntry* walk(int64_t virtualPageNumber) = 0;
+
+        // add an entry for a newly allocated page (valid, not present). returns it
+        virtual pageTableEntry& insert(int64_t virtualPageNumber) = 0;
+        // drop the entry of a deleted page
+        virtual void erase(int64_t virtualPageNumber) = 0;
+
+        // a page was loaded into a frame / left memory. sets the present bit and frame number
+        virtual void map(int64_t virtualPageNumber, int frameNumber);
+        virtual void unmap(int64_t virtualPageNumber);
+
+        // call visit for every allocated page. visit may change entry bits but not insert, erase, map or unmap
+        virtual void forEachPage(const std::function<void(int64_t, pageTableEntry&)>& visit) = 0;
+
+        // bytes the table structure takes up
+        virtual uint64_t memoryFootprint() const = 0;
+
+        uint64_t getWalks() const { return walks; }
+        uint64_t getWalkReferences() const { return walkReferences; }
+        // memory references per walk, 0 if nothing was walked yet
+        double averageWalkReferences() const;
+
+        // print type, walk counters and footprint to std::cout
+        virtual void printStats() const;
+};
+
+// one entry per virtual page, the original layout. a walk is a single reference
+class FlatPageTable : public PageTable {
+    private:
+        std::vector<pageTableEntry> entries;
+
+    public:
+        explicit FlatPageTable(int64_t numPages);
+
+        std::string getName() const override { return "flat"; }
+        pageTableEntry* find(int64_t virtualPageNumber) override;
+        pageTableEntry* walk(int64_t virtualPageNumber) override;
+        pageTableEntry& insert(int64_t virtualPageNumber) override;
+        void erase(int64_t virtualPageNumber) override;
+        void forEachPage(const std::function<void(int64_t, pageTableEntry&)>& visit) override;
+        uint64_t memoryFootprint() const override;
+};
+
+// multi-level radix tree like x86-64's 4-level table. the VPN is split into one index per level;
+// nodes below the root are allocated when a page under them is inserted and freed when their
+// last page is erased. a walk reads one entry per level it reaches
+class RadixPageTable : public PageTable {
+    private:
+        struct Node {
+            std::vector<std::unique_ptr<Node>> children; // interior levels
+            std::vector<pageTableEntry> entries; // last level
+            int used = 0; // occupied slots, node is freed when it drops to 0
+        };
+
+        int LEVELS;
+        std::vector<int> levelBits; // index bits per level, root first
+        std::vector<int> levelShift; // VPN shift per level, root first
+        std::unique_ptr<Node> root;
+        uint64_t nodeBytes = 0; // bytes in all allocated nodes
+        uint64_t nodeCount = 0;
+
+        // index into the node at a level. internal use
+        int _index(int64_t virtualPageNumber, int level) const;
+        // allocate an empty node for a level. internal use
+        std::unique_ptr<Node> _makeNode(int level);
+        // bytes a node at a level takes. internal use
+        uint64_t _nodeBytes(int level) const;
+        // visit every page under a node; base is the VPN bits above this level. internal use
+        void _forEach(Node* node, int level, int64_t base, const std::function<void(int64_t, pageTableEntry&)>& visit);
+
+    public:
+        RadixPageTable(int64_t numPages, int levels);
+
+        std::string getName() const override;
+        pageTableEntry* find(int64_t virtualPageNumber) override;
+        pageTableEntry* walk(int64_t virtualPageNumber) override;
+        pageTableEntry& insert(int64_t virtualPageNumber) override;
+        void erase(int64_t virtualPageNumber) override;
+        void forEachPage(const std::function<void(int64_t, pageTableEntry&)>& visit) override;
+        uint64_t memoryFootprint() const override;
+        void printStats() const override;
+
+        uint64_t getNodeCount() const { return nodeCount; }
+};
+
+// hashed inverted page table: one entry per physical frame, found through a hash anchor table and
+// chained on collisions, so its size follows physical memory rather than the address space. a walk
+// reads the anchor plus every chain entry up to the match. allocated pages that are not in memory are
+// kept in a separate table (the OS's swap bookkeeping) which walks never see
+class InvertedPageTable : public PageTable {
+    private:
+        struct invertedEntry {
+            int64_t virtualPageNumber = -1; // tag, -1 if the frame is free
+            int next = -1; // next frame in the hash chain
+            pageTableEntry entry;
+        };
+
+        std::vector<invertedEntry> frames;
+        std::vector<int> anchors; // hash anchor table: first frame of each chain, -1 if empty
+        std::unordered_map<int64_t, pageTableEntry> notResident;
+
+        // anchor slot for a VPN. internal use
+        size_t _hash(int64_t virtualPageNumber) const;
+        // frame holding a VPN, -1 if not resident. counts references if walking. internal use
+        int _lookup(int64_t virtualPageNumber, bool counted);
+        // take a frame out of its hash chain and clear it. internal use
+        void _unlink(int frameNumber);
+
+    public:
+        explicit InvertedPageTable(int numFrames);
+
+        std::string getName() const override { return "inverted"; }
+        pageTableEntry* find(int64_t virtualPageNumber) override;
+        pageTableEntry* walk(int64_t virtualPageNumber) override;
+        pageTableEntry& insert(int64_t virtualPageNumber) override;
+        void erase(int64_t virtualPageNumber) override;
+        void map(int64_t virtualPageNumber, int frameNumber) override;
+        void unmap(int64_t virtualPageNumber) override;
+        void forEachPage(const std::function<void(int64_t, pageTableEntry&)>& visit) override;
+        uint64_t memoryFootprint() const override;
+        void printStats() const override;
+};
+
+// names accepted by createPageTable
+std::vector<std::string> pageTableNames();
+// build a page table by name (case-insensitive): flat, radix2, radix3, radix4, inverted. returns nullptr for unknown names
+std::unique_ptr<PageTable> createPageTable(const std::string& name, int64_t numPages, int numFrames);
+
+#endif
@@ -0,0 +1,614 @@
+#include <algorithm>
+#include <cctype>
+#include <limits>
+#include <stdexcept>
+#include "PageTable.h"
+#include "ReplacementPolicy.h"
+
+// Clock
+
+int64_t ClockPolicy:: chooseVictim(int64_t incomingVPN, PageLookup& pageTable, const std::vector<int64_t>& frameToVPN) {
+    (void)incomingVPN;
+    int frameCount = frameToVPN.size();
+
+    // only resident pages are visited, so a sweep costs at most two passes over physical memory
+    while (true) {
+        if (clockPointer >= frameCount) clockPointer = 0;
+
+        int64_t candidate = frameToVPN[clockPointer];
+        clockPointer++;
+        if (candidate < 0) continue;
+
+        // with per-process replacement, frames of other address spaces don't resolve and are passed over
+        pageTableEntry* entry = pageTable.find(candidate);
+        if (!entry) continue;
+
+        if (entry->referenceBit) {
+            entry->referenceBit = false;
+        } else {
+            return candidate;
+        }
+    }
+}
+
+// FIFO
+
+void FIFOPolicy:: onLoad(int64_t virtualPageNumber) {
+    queue.push_back(virtualPageNumber);
+    position[virtualPageNumber] = std::prev(queue.end());
+}
+
+void FIFOPolicy:: onRemove(int64_t virtualPageNumber) {
+    auto found = position.find(virtualPageNumber);
+    if (found == position.end()) return;
+    queue.erase(found->second);
+    position.erase(found);
+}
+
+int64_t FIFOPolicy:: chooseVictim(int64_t incomingVPN, PageLookup& pageTable, const std::vector<int64_t>& frameToVPN) {
+    (void)incomingVPN; (void)pageTable; (void)frameToVPN;
+    if (queue.empty()) throw std::logic_error("FIFO has no resident page to evict");
+
+    int64_t victim = queue.front();
+    queue.pop_front();
+    position.erase(victim);
+    return victim;
+}
+
+// Second Chance
+
+void SecondChancePolicy:: onLoad(int64_t virtualPageNumber) {
+    queue.push_back(virtualPageNumber);
+    position[virtualPageNumber] = std::prev(queue.end());
+}
+
+void SecondChancePolicy:: onRemove(int64_t virtualPageNumber) {
+    auto found = position.find(virtualPageNumber);
+    if (found == position.end()) return;
+    queue.erase(found->second);
+    position.erase(found);
+}
+
+int64_t SecondChancePolicy:: chooseVictim(int64_t incomingVPN, PageLookup& pageTable, const std::vector<int64_t>& frameToVPN) {
+    (void)incomingVPN; (void)frameToVPN;
+    if (queue.empty()) throw std::logic_error("Second Chance has no resident page to evict");
+
+    // terminates: every page sent to the back has had its reference bit cleared
+    while (true) {
+        int64_t candidate = queue.front();
+        pageTableEntry& entry = *pageTable.find(candidate);
+        if (!entry.referenceBit) {
+            queue.pop_front();
+            position.erase(candidate);
+            return candidate;
+        }
+        entry.referenceBit = false;
+        queue.splice(queue.end(), queue, queue.begin());
+    }
+}
+
+// LRU
+
+void LRUPolicy:: onLoad(int64_t virtualPageNumber) {
+    recency.push_front(virtualPageNumber);
+    position[virtualPageNumber] = recency.begin();
+}
+
+void LRUPolicy:: onAccess(int64_t virtualPageNumber, bool writeOperation) {
+    (void)writeOperation;
+    auto found = position.find(virtualPageNumber);
+    if (found == position.end()) return;
+    recency.splice(recency.begin(), recency, found->second);
+}
+
+void LRUPolicy:: onRemove(int64_t virtualPageNumber) {
+    auto found = position.find(virtualPageNumber);
+    if (found == position.end()) return;
+    recency.erase(found->second);
+    position.erase(found);
+}
+
+int64_t LRUPolicy:: chooseVictim(int64_t incomingVPN, PageLookup& pageTable, const std::vector<int64_t>& frameToVPN) {
+    (void)incomingVPN; (void)pageTable; (void)frameToVPN;
+    if (recency.empty()) throw std::logic_error("LRU has no resident page to evict");
+
+    int64_t victim = recency.back();
+    recency.pop_back();
+    position.erase(victim);
+    return victim;
+}
+
+// LRU-K
+
+LRUKPolicy:: LRUKPolicy(int k)
+: K(k) {
+    if (K < 1) throw std::invalid_argument("LRU-K needs K >= 1");
+}
+
+void LRUKPolicy:: _touch(int64_t virtualPageNumber) {
+    std::deque<uint64_t>& times = history[virtualPageNumber];
+    times.push_back(++now);
+    if ((int)times.size() > K) times.pop_front();
+}
+
+void LRUKPolicy:: onLoad(int64_t virtualPageNumber) {
+    _touch(virtualPageNumber);
+    residentIndex[virtualPageNumber] = resident.size();
+    resident.push_back(virtualPageNumber);
+}
+
+void LRUKPolicy:: onAccess(int64_t virtualPageNumber, bool writeOperation) {
+    (void)writeOperation;
+    _touch(virtualPageNumber);
+}
+
+void LRUKPolicy:: onRemove(int64_t virtualPageNumber) {
+    history.erase(virtualPageNumber);
+
+    auto found = residentIndex.find(virtualPageNumber);
+    if (found == residentIndex.end()) return;
+    size_t index = found->second;
+    resident[index] = resident.back();
+    residentIndex[resident[index]] = index;
+    resident.pop_back();
+    residentIndex.erase(virtualPageNumber);
+}
+
+int64_t LRUKPolicy:: chooseVictim(int64_t incomingVPN, PageLookup& pageTable, const std::vector<int64_t>& frameToVPN) {
+    (void)incomingVPN; (void)pageTable; (void)frameToVPN;
+    if (resident.empty()) throw std::logic_error("LRU-K has no resident page to evict");
+
+    // pages with fewer than K accesses have an infinite backward K-distance and go first
+    size_t victimIndex = 0;
+    bool victimFull = true;
+    uint64_t victimTime = std::numeric_limits<uint64_t>::max();
+    for (size_t i = 0; i < resident.size(); i++) {
+        const std::deque<uint64_t>& times = history[resident[i]];
+        bool full = (int)times.size() >= K;
+        uint64_t time = full ? times.front() : times.back();
+        if ((victimFull && !full) || (full == victimFull && time < victimTime)) {
+            victimIndex = i;
+            victimFull = full;
+            victimTime = time;
+        }
+    }
+
+    int64_t victim = resident[victimIndex];
+    resident[victimIndex] = resident.back();
+    residentIndex[resident[victimIndex]] = victimIndex;
+    resident.pop_back();
+    residentIndex.erase(victim);
+    return victim;
+}
+
+// WSClock
+
+WSClockPolicy:: WSClockPolicy(uint64_t tau)
+: TAU(tau), hand(ring.end()) {
+}
+
+void WSClockPolicy:: onLoad(int64_t virtualPageNumber) {
+    // new pages go just behind the hand, the last place it will look
+    position[virtualPageNumber] = ring.insert(hand, virtualPageNumber);
+    lastUse[virtualPageNumber] = ++now;
+}
+
+void WSClockPolicy:: onAccess(int64_t virtualPageNumber, bool writeOperation) {
+    (void)virtualPageNumber; (void)writeOperation;
+    // the reference bit records the use; its time is picked up when the hand passes
+    ++now;
+}
+
+void WSClockPolicy:: onRemove(int64_t virtualPageNumber) {
+    auto found = position.find(virtualPageNumber);
+    if (found == position.end()) return;
+    if (hand == found->second) ++hand;
+    ring.erase(found->second);
+    position.erase(found);
+    lastUse.erase(virtualPageNumber);
+}
+
+int64_t WSClockPolicy:: chooseVictim(int64_t incomingVPN, PageLookup& pageTable, const std::vector<int64_t>& frameToVPN) {
+    (void)incomingVPN; (void)frameToVPN;
+    if (ring.empty()) throw std::logic_error("WSClock has no resident page to evict");
+
+    // fallbacks if no clean page outside the working set turns up in two sweeps
+    int64_t oldDirty = -1;
+    int64_t unreferenced = -1;
+    int64_t victim = -1;
+
+    size_t steps = 2 * ring.size();
+    for (size_t step = 0; step < steps; step++) {
+        if (hand == ring.end()) hand = ring.begin();
+
+        int64_t candidate = *hand;
+        pageTableEntry& entry = *pageTable.find(candidate);
+        if (entry.referenceBit) {
+            entry.referenceBit = false;
+            lastUse[candidate] = now;
+        } else if (now - lastUse[candidate] > TAU) {
+            if (!entry.modifyBit) {
+                victim = candidate;
+                break;
+            }
+            // a real WSClock schedules the write-back here and keeps going
+            if (oldDirty == -1) oldDirty = candidate;
+        } else if (unreferenced == -1) {
+            unreferenced = candidate;
+        }
+        ++hand;
+    }
+
+    if (victim == -1) victim = oldDirty;
+    if (victim == -1) victim = unreferenced;
+    if (victim == -1) {
+        if (hand == ring.end()) hand = ring.begin();
+        victim = *hand;
+    }
+
+    onRemove(victim);
+    return victim;
+}
+
+// 2Q
+
+TwoQPolicy:: TwoQPolicy(int numFrames)
+: KIN(std::max(1, numFrames / 4)), KOUT(std::max(1, numFrames / 2)) {
+}
+
+void TwoQPolicy:: onLoad(int64_t virtualPageNumber) {
+    auto found = location.find(virtualPageNumber);
+    if (found != location.end() && found->second.queue == Queue::A1OUT) {
+        // seen again soon after leaving A1in: a hot page
+        a1out.erase(found->second.it);
+        am.push_front(virtualPageNumber);
+        found->second = {Queue::AM, am.begin()};
+        return;
+    }
+
+    a1in.push_back(virtualPageNumber);
+    location[virtualPageNumber] = {Queue::A1IN, std::prev(a1in.end())};
+}
+
+void TwoQPolicy:: onAccess(int64_t virtualPageNumber, bool writeOperation) {
+    (void)writeOperation;
+    auto found = location.find(virtualPageNumber);
+    if (found == location.end() || found->second.queue != Queue::AM) return;
+    am.splice(am.begin(), am, found->second.it);
+}
+
+void TwoQPolicy:: onRemove(int64_t virtualPageNumber) {
+    auto found = location.find(virtualPageNumber);
+    if (found == location.end()) return;
+    switch (found->second.queue) {
+        case Queue::A1IN: a1in.erase(found->second.it); break;
+        case Queue::A1OUT: a1out.erase(found->second.it); break;
+        case Queue::AM: am.erase(found->second.it); break;
+    }
+    location.erase(found);
+}
+
+int64_t TwoQPolicy:: chooseVictim(int64_t incomingVPN, PageLookup& pageTable, const std::vector<int64_t>& frameToVPN) {
+    (void)incomingVPN; (void)pageTable; (void)frameToVPN;
+    if (a1in.empty() && am.empty()) throw std::logic_error("2Q has no resident page to evict");
+
+    if (a1in.size() > KIN || am.empty()) {
+        int64_t victim = a1in.front();
+        a1in.pop_front();
+
+        // remember it in A1out
+        a1out.push_back(victim);
+        location[victim] = {Queue::A1OUT, std::prev(a1out.end())};
+        if (a1out.size() > KOUT) {
+            location.erase(a1out.front());
+            a1out.pop_front();
+        }
+        return victim;
+    }
+
+    int64_t victim = am.back();
+    am.pop_back();
+    location.erase(victim);
+    return victim;
+}
+
+// ARC
+
+ARCPolicy:: ARCPolicy(int numFrames)
+: C(std::max(1, numFrames)) {
+}
+
+std::list<int64_t>& ARCPolicy:: _list(List which) {
+    switch (which) {
+        case List::T1: return t1;
+        case List::T2: return t2;
+        case List::B1: return b1;
+        case List::B2: return b2;
+    }
+    return t1;
+}
+
+void ARCPolicy:: _moveTo(int64_t virtualPageNumber, List which) {
+    auto found = location.find(virtualPageNumber);
+    if (found != location.end()) {
+        _list(found->second.list).erase(found->second.it);
+    }
+    std::list<int64_t>& target = _list(which);
+    target.push_front(virtualPageNumber);
+    location[virtualPageNumber] = {which, target.begin()};
+}
+
+void ARCPolicy:: _dropGhost(List which) {
+    std::list<int64_t>& ghosts = _list(which);
+    if (ghosts.empty()) return;
+    location.erase(ghosts.back());
+    ghosts.pop_back();
+}
+
+void ARCPolicy:: _adapt(int64_t virtualPageNumber) {
+    auto found = location.find(virtualPageNumber);
+    if (found == location.end()) return;
+
+    if (found->second.list == List::B1) {
+        size_t delta = std::max<size_t>(1, b2.size() / b1.size());
+        p = std::min(C, p + delta);
+    } else if (found->second.list == List::B2) {
+        size_t delta = std::max<size_t>(1, b1.size() / b2.size());
+        p = p > delta ? p - delta : 0;
+    }
+}
+
+void ARCPolicy:: onLoad(int64_t virtualPageNumber) {
+    auto found = location.find(virtualPageNumber);
+    bool ghost = found != location.end() && (found->second.list == List::B1 || found->second.list == List::B2);
+
+    if (ghost) {
+        // p was already adjusted if this load needed an eviction
+        if (adaptedFor != virtualPageNumber) _adapt(virtualPageNumber);
+        adaptedFor = -1;
+        _moveTo(virtualPageNumber, List::T2);
+        return;
+    }
+
+    adaptedFor = -1;
+    // keep the directory within 2c pages
+    if (t1.size() + b1.size() >= C && !b1.empty()) {
+        _dropGhost(List::B1);
+    } else if (t1.size() + t2.size() + b1.size() + b2.size() >= 2 * C) {
+        _dropGhost(List::B2);
+    }
+    _moveTo(virtualPageNumber, List::T1);
+}
+
+void ARCPolicy:: onAccess(int64_t virtualPageNumber, bool writeOperation) {
+    (void)writeOperation;
+    auto found = location.find(virtualPageNumber);
+    if (found == location.end()) return;
+    if (found->second.list == List::T1 || found->second.list == List::T2) {
+        _moveTo(virtualPageNumber, List::T2);
+    }
+}
+
+void ARCPolicy:: onRemove(int64_t virtualPageNumber) {
+    auto found = location.find(virtualPageNumber);
+    if (found == location.end()) return;
+    _list(found->second.list).erase(found->second.it);
+    location.erase(found);
+}
+
+int64_t ARCPolicy:: chooseVictim(int64_t incomingVPN, PageLookup& pageTable, const std::vector<int64_t>& frameToVPN) {
+    (void)pageTable; (void)frameToVPN;
+    if (t1.empty() && t2.empty()) throw std::logic_error("ARC has no resident page to evict");
+
+    auto found = location.find(incomingVPN);
+    bool inB1 = found != location.end() && found->second.list == List::B1;
+    bool inB2 = found != location.end() && found->second.list == List::B2;
+    if (inB1 || inB2) {
+        _adapt(incomingVPN);
+        adaptedFor = incomingVPN;
+    } else if (t1.size() + b1.size() >= C && b1.empty()) {
+        // T1 alone fills the cache: its LRU page leaves without becoming a ghost
+        int64_t victim = t1.back();
+        t1.pop_back();
+        location.erase(victim);
+        return victim;
+    }
+
+    // REPLACE(x, p)
+    bool fromT1 = !t1.empty() && (t1.size() > p || (inB2 && t1.size() == p) || t2.empty());
+    List from = fromT1 ? List::T1 : List::T2;
+    int64_t victim = _list(from).back();
+    _moveTo(victim, fromT1 ? List::B1 : List::B2);
+    return victim;
+}
+
+// CAR
+
+CARPolicy:: CARPolicy(int numFrames)
+: C(std::max(1, numFrames)) {
+}
+
+std::list<int64_t>& CARPolicy:: _list(List which) {
+    switch (which) {
+        case List::T1: return t1;
+        case List::T2: return t2;
+        case List::B1: return b1;
+        case List::B2: return b2;
+    }
+    return t1;
+}
+
+void CARPolicy:: _erase(int64_t virtualPageNumber) {
+    auto found = location.find(virtualPageNumber);
+    if (found == location.end()) return;
+    _list(found->second.list).erase(found->second.it);
+    location.erase(found);
+}
+
+void CARPolicy:: _dropGhost(List which) {
+    std::list<int64_t>& ghosts = _list(which);
+    if (ghosts.empty()) return;
+    location.erase(ghosts.back());
+    ghosts.pop_back();
+}
+
+void CARPolicy:: onLoad(int64_t virtualPageNumber) {
+    auto found = location.find(virtualPageNumber);
+    bool inB1 = found != location.end() && found->second.list == List::B1;
+    bool inB2 = found != location.end() && found->second.list == List::B2;
+
+    if (!inB1 && !inB2) {
+        // keep the directory within 2c pages
+        if (t1.size() + b1.size() >= C && !b1.empty()) {
+            _dropGhost(List::B1);
+        } else if (t1.size() + t2.size() + b1.size() + b2.size() >= 2 * C) {
+            _dropGhost(List::B2);
+        }
+        t1.push_back(virtualPageNumber);
+        location[virtualPageNumber] = {List::T1, std::prev(t1.end()), false};
+        return;
+    }
+
+    if (inB1) {
+        size_t delta = std::max<size_t>(1, b2.size() / b1.size());
+        p = std::min(C, p + delta);
+    } else {
+        size_t delta = std::max<size_t>(1, b1.size() / b2.size());
+        p = p > delta ? p - delta : 0;
+    }
+    _erase(virtualPageNumber);
+    t2.push_back(virtualPageNumber);
+    location[virtualPageNumber] = {List::T2, std::prev(t2.end()), false};
+}
+
+void CARPolicy:: onAccess(int64_t virtualPageNumber, bool writeOperation) {
+    (void)writeOperation;
+    auto found = location.find(virtualPageNumber);
+    if (found == location.end()) return;
+    if (found->second.list == List::T1 || found->second.list == List::T2) {
+        found->second.referenced = true;
+    }
+}
+
+void CARPolicy:: onRemove(int64_t virtualPageNumber) {
+    _erase(virtualPageNumber);
+}
+
+int64_t CARPolicy:: chooseVictim(int64_t incomingVPN, PageLookup& pageTable, const std::vector<int64_t>& frameToVPN) {
+    (void)incomingVPN; (void)pageTable; (void)frameToVPN;
+    if (t1.empty() && t2.empty()) throw std::logic_error("CAR has no resident page to evict");
+
+    // terminates: every page the hands pass over loses its reference bit
+    while (true) {
+        if (!t1.empty() && (t1.size() >= std::max<size_t>(1, p) || t2.empty())) {
+            int64_t candidate = t1.front();
+            Location& where = location[candidate];
+            if (!where.referenced) {
+                t1.pop_front();
+                b1.push_front(candidate);
+                where = {List::B1, b1.begin(), false};
+                return candidate;
+            }
+            // referenced while in T1: seen more than once, promote
+            t2.splice(t2.end(), t1, t1.begin());
+            where = {List::T2, std::prev(t2.end()), false};
+        } else {
+            int64_t candidate = t2.front();
+            Location& where = location[candidate];
+            if (!where.referenced) {
+                t2.pop_front();
+                b2.push_front(candidate);
+                where = {List::B2, b2.begin(), false};
+                return candidate;
+            }
+            where.referenced = false;
+            t2.splice(t2.end(), t2, t2.begin());
+        }
+    }
+}
+
+// OPT
+
+OptimalPolicy:: OptimalPolicy(const std::vector<int64_t>& pageTrace) {
+    for (size_t i = 0; i < pageTrace.size(); i++) {
+        uses[pageTrace[i]].push_back(i);
+    }
+}
+
+void OptimalPolicy:: _advance(int64_t virtualPageNumber) {
+    std::deque<uint64_t>& upcoming = uses[virtualPageNumber];
+    while (!upcoming.empty() && upcoming.front() <= cursor) upcoming.pop_front();
+    cursor++;
+}
+
+void OptimalPolicy:: onLoad(int64_t virtualPageNumber) {
+    _advance(virtualPageNumber);
+    residentIndex[virtualPageNumber] = resident.size();
+    resident.push_back(virtualPageNumber);
+}
+
+void OptimalPolicy:: onAccess(int64_t virtualPageNumber, bool writeOperation) {
+    (void)writeOperation;
+    _advance(virtualPageNumber);
+}
+
+void OptimalPolicy:: onRemove(int64_t virtualPageNumber) {
+    uses.erase(virtualPageNumber);
+
+    auto found = residentIndex.find(virtualPageNumber);
+    if (found == residentIndex.end()) return;
+    size_t index = found->second;
+    resident[index] = resident.back();
+    residentIndex[resident[index]] = index;
+    resident.pop_back();
+    residentIndex.erase(virtualPageNumber);
+}
+
+int64_t OptimalPolicy:: chooseVictim(int64_t incomingVPN, PageLookup& pageTable, const std::vector<int64_t>& frameToVPN) {
+    (void)incomingVPN; (void)pageTable; (void)frameToVPN;
+    if (resident.empty()) throw std::logic_error("OPT has no resident page to evict");
+
+    size_t victimIndex = 0;
+    uint64_t furthest = 0;
+    for (size_t i = 0; i < resident.size(); i++) {
+        std::deque<uint64_t>& upcoming = uses[resident[i]];
+        while (!upcoming.empty() && upcoming.front() < cursor) upcoming.pop_front();
+
+        // never used again beats everything
+        uint64_t nextUse = upcoming.empty() ? std::numeric_limits<uint64_t>::max() : upcoming.front();
+        if (i == 0 || nextUse > furthest) {
+            victimIndex = i;
+            furthest = nextUse;
+        }
+    }
+
+    int64_t victim = resident[victimIndex];
+    resident[victimIndex] = resident.back();
+    residentIndex[resident[victimIndex]] = victimIndex;
+    resident.pop_back();
+    residentIndex.erase(victim);
+    return victim;
+}
+
+// factory
+
+std::vector<std::string> replacementPolicyNames() {
+    return {"Clock", "FIFO", "SecondChance", "LRU", "LRU-2", "WSClock", "2Q", "ARC", "CAR"};
+}
+
+std::unique_ptr<ReplacementPolicy> createReplacementPolicy(const std::string& name, int numFrames) {
+    std::string key = name;
+    std::transform(key.begin(), key.end(), key.begin(), [](unsigned char c) { return std::tolower(c); });
+
+    if (key == "clock") return std::make_unique<ClockPolicy>();
+    if (key == "fifo") return std::make_unique<FIFOPolicy>();
+    if (key == "secondchance" || key == "second-chance") return std::make_unique<SecondChancePolicy>();
+    if (key == "lru") return std::make_unique<LRUPolicy>();
+    if (key == "lru-2" || key == "lru-k") return std::make_unique<LRUKPolicy>(2);
+    // window of a few accesses per frame; smaller and everything looks outside the working set
+    if (key == "wsclock") return std::make_unique<WSClockPolicy>(4 * (uint64_t)std::max(1, numFrames));
+    if (key == "2q") return std::make_unique<TwoQPolicy>(numFrames);
+    if (key == "arc") return std::make_unique<ARCPolicy>(numFrames);
+    if (key == "car") return std::make_unique<CARPolicy>(numFrames);
+    return nullptr;
+}
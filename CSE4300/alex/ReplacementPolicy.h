@@ -0,0 +1,246 @@
+#include <vector>
+#include <list>
+#include <deque>
+#include <string>
+#include <memory>
+#include <cstdint>
+#include <unordered_map>
+
+#ifndef REPLACEMENTPOLICY_H
+#define REPLACEMENTPOLICY_H
+
+class PageLookup;
+
+// Decides which resident page to evict when MemoryManager runs out of frames.
+// MemoryManager reports every page that becomes resident (onLoad), every access to a
+// page that was already resident (onAccess) and every deleted page (onRemove), and asks
+// for a victim when it needs a frame. The reference/modify bits in the page table are
+// kept up to date by MemoryManager, so clock-style policies can read and clear them.
+class ReplacementPolicy {
+    public:
+        virtual ~ReplacementPolicy() = default;
+
+        // name of the policy, for printing
+        virtual std::string getName() const = 0;
+
+        // a page was brought into memory (allocated or faulted in)
+        virtual void onLoad(int64_t virtualPageNumber) = 0;
+        // a resident page was read or written
+        virtual void onAccess(int64_t virtualPageNumber, bool writeOperation) { (void)virtualPageNumber; (void)writeOperation; }
+        // a page was deleted; forget everything about it, including history kept after eviction
+        virtual void onRemove(int64_t virtualPageNumber) = 0;
+
+        // pick a resident page to evict so incomingVPN can be loaded. frameToVPN maps each frame to
+        // the page in it (-1 if free). the policy stops tracking the victim as resident (adaptive
+        // policies may remember it as a ghost). returns victim VPN
+        // (with several address spaces, "VPNs" here are MemoryManager's page keys: ASID and VPN packed together)
+        virtual int64_t chooseVictim(int64_t incomingVPN, PageLookup& pageTable, const std::vector<int64_t>& frameToVPN) = 0;
+};
+
+// CLOCK: a hand circles the physical frames, clearing reference bits until it finds an unreferenced page
+class ClockPolicy : public ReplacementPolicy {
+    private:
+        int clockPointer = 0; // frame the hand points at
+
+    public:
+        std::string getName() const override { return "Clock"; }
+        void onLoad(int64_t virtualPageNumber) override { (void)virtualPageNumber; }
+        void onRemove(int64_t virtualPageNumber) override { (void)virtualPageNumber; }
+        int64_t chooseVictim(int64_t incomingVPN, PageLookup& pageTable, const std::vector<int64_t>& frameToVPN) override;
+};
+
+// evict the page that has been resident the longest
+class FIFOPolicy : public ReplacementPolicy {
+    private:
+        std::list<int64_t> queue; // oldest at front
+        std::unordered_map<int64_t, std::list<int64_t>::iterator> position;
+
+    public:
+        std::string getName() const override { return "FIFO"; }
+        void onLoad(int64_t virtualPageNumber) override;
+        void onRemove(int64_t virtualPageNumber) override;
+        int64_t chooseVictim(int64_t incomingVPN, PageLookup& pageTable, const std::vector<int64_t>& frameToVPN) override;
+};
+
+// FIFO, but a page whose reference bit is set gets its bit cleared and goes to the back of the queue
+class SecondChancePolicy : public ReplacementPolicy {
+    private:
+        std::list<int64_t> queue; // oldest at front
+        std::unordered_map<int64_t, std::list<int64_t>::iterator> position;
+
+    public:
+        std::string getName() const override { return "SecondChance"; }
+        void onLoad(int64_t virtualPageNumber) override;
+        void onRemove(int64_t virtualPageNumber) override;
+        int64_t chooseVictim(int64_t incomingVPN, PageLookup& pageTable, const std::vector<int64_t>& frameToVPN) override;
+};
+
+// evict the least recently used page
+class LRUPolicy : public ReplacementPolicy {
+    private:
+        std::list<int64_t> recency; // most recent at front
+        std::unordered_map<int64_t, std::list<int64_t>::iterator> position;
+
+    public:
+        std::string getName() const override { return "LRU"; }
+        void onLoad(int64_t virtualPageNumber) override;
+        void onAccess(int64_t virtualPageNumber, bool writeOperation) override;
+        void onRemove(int64_t virtualPageNumber) override;
+        int64_t chooseVictim(int64_t incomingVPN, PageLookup& pageTable, const std::vector<int64_t>& frameToVPN) override;
+};
+
+// evict the page whose K-th most recent access is oldest. pages with fewer than K accesses go
+// first (oldest last access among them). access history survives eviction
+class LRUKPolicy : public ReplacementPolicy {
+    private:
+        int K;
+        uint64_t now = 0; // virtual time, ticks per load/access
+        std::unordered_map<int64_t, std::deque<uint64_t>> history; // last K access times, newest at back
+        std::vector<int64_t> resident;
+        std::unordered_map<int64_t, size_t> residentIndex;
+
+        // record an access at the current virtual time. internal use
+        void _touch(int64_t virtualPageNumber);
+
+    public:
+        explicit LRUKPolicy(int k = 2);
+
+        std::string getName() const override { return "LRU-" + std::to_string(K); }
+        void onLoad(int64_t virtualPageNumber) override;
+        void onAccess(int64_t virtualPageNumber, bool writeOperation) override;
+        void onRemove(int64_t virtualPageNumber) override;
+        int64_t chooseVictim(int64_t incomingVPN, PageLookup& pageTable, const std::vector<int64_t>& frameToVPN) override;
+};
+
+// WSClock: a clock over resident pages that evicts clean pages outside the working set window (tau
+// accesses). dirty old pages are passed over while a clean one might still be found
+class WSClockPolicy : public ReplacementPolicy {
+    private:
+        uint64_t TAU; // working set window in accesses
+        uint64_t now = 0; // virtual time, ticks per access
+        std::list<int64_t> ring;
+        std::list<int64_t>::iterator hand;
+        std::unordered_map<int64_t, std::list<int64_t>::iterator> position;
+        std::unordered_map<int64_t, uint64_t> lastUse;
+
+    public:
+        explicit WSClockPolicy(uint64_t tau);
+
+        std::string getName() const override { return "WSClock"; }
+        void onLoad(int64_t virtualPageNumber) override;
+        void onAccess(int64_t virtualPageNumber, bool writeOperation) override;
+        void onRemove(int64_t virtualPageNumber) override;
+        int64_t chooseVictim(int64_t incomingVPN, PageLookup& pageTable, const std::vector<int64_t>& frameToVPN) override;
+};
+
+// full 2Q (Johnson & Shasha): first-time pages wait in a FIFO (A1in); pages referenced again after
+// leaving it (remembered in the A1out ghost queue) are promoted to an LRU list (Am)
+class TwoQPolicy : public ReplacementPolicy {
+    private:
+        size_t KIN; // A1in target size, 25% of frames
+        size_t KOUT; // A1out ghost size, 50% of frames
+        std::list<int64_t> a1in; // oldest at front
+        std::list<int64_t> a1out; // oldest at front, not resident
+        std::list<int64_t> am; // most recent at front
+
+        enum class Queue { A1IN, A1OUT, AM };
+        struct Location { Queue queue; std::list<int64_t>::iterator it; };
+        std::unordered_map<int64_t, Location> location;
+
+    public:
+        explicit TwoQPolicy(int numFrames);
+
+        std::string getName() const override { return "2Q"; }
+        void onLoad(int64_t virtualPageNumber) override;
+        void onAccess(int64_t virtualPageNumber, bool writeOperation) override;
+        void onRemove(int64_t virtualPageNumber) override;
+        int64_t chooseVictim(int64_t incomingVPN, PageLookup& pageTable, const std::vector<int64_t>& frameToVPN) override;
+};
+
+// ARC (Megiddo & Modha): LRU lists for pages seen once (T1) and more than once (T2), with ghost
+// lists (B1, B2) of recently evicted pages that steer the target size p of T1
+class ARCPolicy : public ReplacementPolicy {
+    private:
+        size_t C; // number of frames
+        size_t p = 0; // target size of T1
+        std::list<int64_t> t1, t2, b1, b2; // most recent at front
+        int64_t adaptedFor = -1; // VPN whose ghost hit already adjusted p in chooseVictim
+
+        enum class List { T1, T2, B1, B2 };
+        struct Location { List list; std::list<int64_t>::iterator it; };
+        std::unordered_map<int64_t, Location> location;
+
+        std::list<int64_t>& _list(List which);
+        // move a page to the front of a list. internal use
+        void _moveTo(int64_t virtualPageNumber, List which);
+        // drop the LRU page of a ghost list. internal use
+        void _dropGhost(List which);
+        // adjust p for a ghost hit. internal use
+        void _adapt(int64_t virtualPageNumber);
+
+    public:
+        explicit ARCPolicy(int numFrames);
+
+        std::string getName() const override { return "ARC"; }
+        void onLoad(int64_t virtualPageNumber) override;
+        void onAccess(int64_t virtualPageNumber, bool writeOperation) override;
+        void onRemove(int64_t virtualPageNumber) override;
+        int64_t chooseVictim(int64_t incomingVPN, PageLookup& pageTable, const std::vector<int64_t>& frameToVPN) override;
+};
+
+// CAR (Bansal & Modha): ARC with the T1/T2 LRU lists replaced by clocks, so a hit only sets a
+// reference bit. keeps its own bits: a newly loaded page must start unreferenced, but the page
+// table's bit is set by the access that faulted it in
+class CARPolicy : public ReplacementPolicy {
+    private:
+        size_t C; // number of frames
+        size_t p = 0; // target size of T1
+        std::list<int64_t> t1, t2; // clocks, hand at front
+        std::list<int64_t> b1, b2; // ghosts, most recent at front
+
+        enum class List { T1, T2, B1, B2 };
+        struct Location { List list; std::list<int64_t>::iterator it; bool referenced; };
+        std::unordered_map<int64_t, Location> location;
+
+        std::list<int64_t>& _list(List which);
+        void _erase(int64_t virtualPageNumber);
+        void _dropGhost(List which);
+
+    public:
+        explicit CARPolicy(int numFrames);
+
+        std::string getName() const override { return "CAR"; }
+        void onLoad(int64_t virtualPageNumber) override;
+        void onAccess(int64_t virtualPageNumber, bool writeOperation) override;
+        void onRemove(int64_t virtualPageNumber) override;
+        int64_t chooseVictim(int64_t incomingVPN, PageLookup& pageTable, const std::vector<int64_t>& frameToVPN) override;
+};
+
+// Belady's OPT for offline traces: evict the resident page whose next use is furthest in the future.
+// needs the page-level trace up front, and onLoad/onAccess must follow it exactly
+class OptimalPolicy : public ReplacementPolicy {
+    private:
+        uint64_t cursor = 0; // index of the next access in the trace
+        std::unordered_map<int64_t, std::deque<uint64_t>> uses; // upcoming trace positions per VPN
+        std::vector<int64_t> resident;
+        std::unordered_map<int64_t, size_t> residentIndex;
+
+        // consume the current trace position for a page. internal use
+        void _advance(int64_t virtualPageNumber);
+
+    public:
+        explicit OptimalPolicy(const std::vector<int64_t>& pageTrace);
+
+        std::string getName() const override { return "OPT"; }
+        void onLoad(int64_t virtualPageNumber) override;
+        void onAccess(int64_t virtualPageNumber, bool writeOperation) override;
+        void onRemove(int64_t virtualPageNumber) override;
+        int64_t chooseVictim(int64_t incomingVPN, PageLookup& pageTable, const std::vector<int64_t>& frameToVPN) override;
+};
+
+// names accepted by createReplacementPolicy (OPT needs a trace, so it is built directly)
+std::vector<std::string> replacementPolicyNames();
+// build an online policy by name (case-insensitive). returns nullptr for unknown names
+std::unique_ptr<ReplacementPolicy> createReplacementPolicy(const std::string& name, int numFrames);
+
+#endif
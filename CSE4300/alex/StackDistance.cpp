@@ -0,0 +1,135 @@
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include "StackDistance.h"
+
+StackDistanceAnalyzer:: StackDistanceAnalyzer(double samplingRate, size_t maxPages)
+: maxPages(maxPages), tree(1024){
+    if (!(samplingRate > 0 && samplingRate <= 1)) throw std::invalid_argument("Sampling rate must be in (0, 1]");
+    threshold = std::max<uint64_t>(1, (uint64_t)std::llround(samplingRate * HASH_MODULUS));
+}
+
+uint64_t StackDistanceAnalyzer:: _hash(int64_t page) {
+    // splitmix64 finalizer, so neighbouring pages land far apart
+    uint64_t x = (uint64_t)page + 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    x = x ^ (x >> 31);
+    return x & (HASH_MODULUS - 1);
+}
+
+uint64_t StackDistanceAnalyzer:: _depthKey(uint64_t depth) const {
+    if (!isSampled()) return depth;
+
+    uint64_t scaled = (uint64_t)std::llround(depth / getSamplingRate());
+    int shift = 0;
+    while ((scaled >> shift) >= 256) shift++;
+    return ((scaled + ((uint64_t)1 << shift) - 1) >> shift) << shift;
+}
+
+void StackDistanceAnalyzer:: _add(uint64_t slot, int delta) {
+    for (uint64_t i = slot + 1; i <= tree.size(); i += i & (~i + 1)) tree[i - 1] += delta;
+}
+
+uint64_t StackDistanceAnalyzer:: _prefix(uint64_t slot) const {
+    uint64_t sum = 0;
+    for (uint64_t i = slot + 1; i > 0; i -= i & (~i + 1)) sum += tree[i - 1];
+    return sum;
+}
+
+void StackDistanceAnalyzer:: _compact() {
+    // only the order of last references matters, so the live slots can be renumbered 0..n-1
+    std::vector<std::pair<uint64_t, int64_t>> live;
+    live.reserve(lastUse.size());
+    for (const auto& [page, slot] : lastUse) live.push_back({slot, page});
+    std::sort(live.begin(), live.end());
+
+    tree.assign(std::max<size_t>(1024, 2 * live.size()), 0);
+    for (size_t i = 0; i < live.size(); i++) {
+        lastUse[live[i].second] = i;
+        tree[i] = 1;
+    }
+    // linear Fenwick build: each node passes its total on to its parent
+    for (size_t i = 0; i < tree.size(); i++) {
+        size_t parent = i + ((i + 1) & (~(i + 1) + 1));
+        if (parent < tree.size()) tree[parent] += tree[i];
+    }
+    nextSlot = live.size();
+}
+
+void StackDistanceAnalyzer:: _forget(int64_t page) {
+    auto it = lastUse.find(page);
+    if (it == lastUse.end()) return;
+
+    _add(it->second, -1);
+    lastUse.erase(it);
+}
+
+void StackDistanceAnalyzer:: _shrinkSample() {
+    while (lastUse.size() > maxPages && !sampledByHash.empty()) {
+        double oldRate = getSamplingRate();
+
+        // the highest hash still tracked becomes the new threshold, dropping every page at or above it
+        threshold = std::prev(sampledByHash.end())->first;
+        while (!sampledByHash.empty() && std::prev(sampledByHash.end())->first >= threshold) {
+            _forget(std::prev(sampledByHash.end())->second);
+            sampledByHash.erase(std::prev(sampledByHash.end()));
+        }
+
+        // what was counted so far stands for a larger share of the pages than is sampled from now on
+        weightScale *= getSamplingRate() / oldRate;
+    }
+}
+
+void StackDistanceAnalyzer:: access(int64_t page) {
+    references++;
+
+    uint64_t hash = _hash(page);
+    if (hash >= threshold) return;
+    sampledReferences++;
+
+    if (nextSlot == tree.size()) _compact();
+
+    auto it = lastUse.find(page);
+    if (it == lastUse.end()) {
+        coldWeight += 1 / weightScale;
+        lastUse[page] = nextSlot;
+        if (maxPages > 0) sampledByHash.insert({hash, page});
+    } else {
+        // every tracked page is marked once and all marks are below nextSlot, so the pages touched since
+        // this one are the marks after its slot. the page itself is at the top of its own stack, depth 1
+        uint64_t depth = lastUse.size() - _prefix(it->second) + 1;
+        histogram[_depthKey(depth)] += 1 / weightScale;
+
+        _add(it->second, -1);
+        it->second = nextSlot;
+    }
+    _add(nextSlot, 1);
+    nextSlot++;
+
+    if (maxPages > 0 && lastUse.size() > maxPages) _shrinkSample();
+}
+
+double StackDistanceAnalyzer:: misses(int64_t frames) const {
+    double missWeight = coldWeight;
+    for (auto it = histogram.upper_bound((uint64_t)std::max<int64_t>(frames, 0)); it != histogram.end(); ++it)
+        missWeight += it->second;
+    // scaled-up sample estimates can overshoot the stream itself
+    return std::min((double)references, missWeight * weightScale / getSamplingRate());
+}
+
+double StackDistanceAnalyzer:: missRatio(int64_t frames) const {
+    if (references == 0) return 0.0;
+
+    // divide by the references expected in the sample rather than the ones that were, so a sample that
+    // happened to catch a few hot pages doesn't skew every size (the SHARDS adjustment)
+    return misses(frames) / references;
+}
+
+int64_t StackDistanceAnalyzer:: getResolution() const {
+    return (int64_t)std::ceil(2.0 / getSamplingRate());
+}
+
+double StackDistanceAnalyzer:: getDistinctPages() const {
+    return coldWeight * weightScale / getSamplingRate();
+}
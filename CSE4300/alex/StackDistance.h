@@ -0,0 +1,84 @@
+#include <map>
+#include <set>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <unordered_map>
+
+#ifndef STACKDISTANCE_H
+#define STACKDISTANCE_H
+
+// Computes the whole LRU miss-ratio curve of a page-reference stream in one pass (Mattson's stack
+// algorithm). A reference to a page at LRU stack depth d hits in every memory of d frames or more,
+// so a histogram of depths gives the miss ratio of every memory size at once.
+// The depth is the number of distinct pages touched since the page's last reference. Each page
+// keeps one mark in a Fenwick tree at the time of its last reference, so the depth is a prefix-sum
+// query and a reference costs O(log n) instead of a walk down the stack.
+//
+// With sampling (SHARDS) only pages whose hash falls under a threshold are tracked, and their depths
+// are scaled up by 1/rate. A fixed rate keeps about rate of the pages; with a page limit the rate is
+// lowered whenever more pages than that are tracked, so memory stays bounded on any trace.
+class StackDistanceAnalyzer {
+    private:
+        static const uint64_t HASH_MODULUS = (uint64_t)1 << 24; // sampling thresholds are out of this
+
+        uint64_t threshold; // pages hashing under this are sampled
+        size_t maxPages; // 0 for no limit
+
+        uint64_t references = 0; // every reference seen, sampled or not
+        uint64_t sampledReferences = 0;
+
+        std::unordered_map<int64_t, uint64_t> lastUse; // sampled page -> slot of its last reference
+        std::vector<uint32_t> tree; // Fenwick tree over the slots, 1 where a page's last reference is
+        uint64_t nextSlot = 0;
+        std::set<std::pair<uint64_t, int64_t>> sampledByHash; // tracked pages by hash, only with a page limit
+
+        // scaled stack depth -> weight of references at that depth. when sampling, depths are rounded up to
+        // 8 significant bits so the histogram stays small however often the rate changes
+        std::map<uint64_t, double> histogram;
+        double coldWeight = 0; // first references, a miss at any size
+        double weightScale = 1; // stored weights times this are the real ones; lowering the rate only touches this
+
+        // hash used for sampling. internal use
+        static uint64_t _hash(int64_t page);
+        // histogram key for a stack depth in the sample. internal use
+        uint64_t _depthKey(uint64_t depth) const;
+        // Fenwick tree update / sum of slots [0, slot]. internal use
+        void _add(uint64_t slot, int delta);
+        uint64_t _prefix(uint64_t slot) const;
+        // renumber the live slots from 0 once the tree is full, so it grows with the pages, not the trace. internal use
+        void _compact();
+        // stop tracking a page (lowering the sampling threshold). internal use
+        void _forget(int64_t page);
+        // lower the threshold until no more than maxPages pages are tracked, rescaling the histogram. internal use
+        void _shrinkSample();
+
+    public:
+        // samplingRate 1 and maxPages 0 is the exact curve. with maxPages set, sampling starts at samplingRate
+        // and is lowered as needed. throws std::invalid_argument for a rate outside (0, 1]
+        explicit StackDistanceAnalyzer(double samplingRate = 1.0, size_t maxPages = 0);
+
+        // feed the next reference
+        void access(int64_t page);
+
+        // estimated miss ratio of an LRU memory with this many frames, first references included
+        double missRatio(int64_t frames) const;
+        // estimated misses over the whole stream with this many frames, at most getReferences()
+        double misses(int64_t frames) const;
+        // smallest memory a sampled curve can say anything about. each sampled depth stands for 1/rate frames,
+        // so a smaller memory sees no sampled hits at all and one under 2/rate only sees the hottest sampled
+        // pages re-referencing themselves. 1 if exact
+        int64_t getResolution() const;
+
+        // fraction of pages sampled right now, 1 for the exact curve
+        double getSamplingRate() const { return (double)threshold / HASH_MODULUS; }
+        bool isSampled() const { return threshold < HASH_MODULUS; }
+        uint64_t getReferences() const { return references; }
+        uint64_t getSampledReferences() const { return sampledReferences; }
+        // distinct pages in the stream (estimated when sampling); no memory larger than this misses less
+        double getDistinctPages() const;
+        // pages being tracked, which is what the analyzer's memory grows with
+        size_t getTrackedPages() const { return lastUse.size(); }
+};
+
+#endif
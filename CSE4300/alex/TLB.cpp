@@ -0,0 +1,193 @@
+#include <iostream>
+#include <stdexcept>
+#include "TLB.h"
+
+// constructors
+
+TLB:: TLB()
+: TLB(64, 4){
+}
+
+TLB:: TLB(int num_entries, int associativity, TLBReplacement policy, int hit_cycles, int miss_cycles)
+: ENTRY_COUNT(num_entries), ASSOCIATIVITY(associativity), replacement(policy),
+  HIT_CYCLES(hit_cycles), MISS_CYCLES(miss_cycles), randomGenerator(4300){
+    if (num_entries <= 0 || associativity <= 0)
+        throw std::invalid_argument("TLB entries and associativity must be positive");
+    if (num_entries % associativity != 0)
+        throw std::invalid_argument("TLB entries must be a multiple of the associativity");
+
+    numSets = ENTRY_COUNT / ASSOCIATIVITY;
+    entries.resize(ENTRY_COUNT);
+}
+
+// private methods
+
+int TLB:: _setStart(int64_t virtualPageNumber) const {
+    return (int)(virtualPageNumber % numSets) * ASSOCIATIVITY;
+}
+
+int TLB:: _find(int asid, int64_t virtualPageNumber) const {
+    int setStart = _setStart(virtualPageNumber);
+    for (int i = setStart; i < setStart + ASSOCIATIVITY; i++) {
+        const tlbEntry& entry = entries[i];
+        if (entry.validBit && !entry.huge && entry.virtualPageNumber == virtualPageNumber && entry.asid == asid) return i;
+    }
+
+    // huge entries live in the set of their huge page number
+    if (HUGE_SHIFT > 0) {
+        int64_t hugePage = virtualPageNumber >> HUGE_SHIFT;
+        setStart = _setStart(hugePage);
+        for (int i = setStart; i < setStart + ASSOCIATIVITY; i++) {
+            const tlbEntry& entry = entries[i];
+            if (entry.validBit && entry.huge && (entry.virtualPageNumber >> HUGE_SHIFT) == hugePage && entry.asid == asid) return i;
+        }
+    }
+    return -1;
+}
+
+int TLB:: _chooseVictim(int setStart) {
+    // empty slots first
+    for (int i = setStart; i < setStart + ASSOCIATIVITY; i++) {
+        if (!entries[i].validBit) return i;
+    }
+
+    evictions++;
+
+    if (replacement == TLBReplacement::RANDOM) {
+        std::uniform_int_distribution<int> way(0, ASSOCIATIVITY - 1);
+        return setStart + way(randomGenerator);
+    }
+
+    int victim = setStart;
+    for (int i = setStart + 1; i < setStart + ASSOCIATIVITY; i++) {
+        uint64_t candidateAge = replacement == TLBReplacement::LRU ? entries[i].lastUsed : entries[i].insertedAt;
+        uint64_t victimAge = replacement == TLBReplacement::LRU ? entries[victim].lastUsed : entries[victim].insertedAt;
+        if (candidateAge < victimAge) victim = i;
+    }
+    return victim;
+}
+
+// public methods
+
+bool TLB:: lookup(int asid, int64_t virtualPageNumber, int& frameNumber) {
+    accessClock++;
+
+    int found = _find(asid, virtualPageNumber);
+    if (found == -1) {
+        misses++;
+        return false;
+    }
+
+    tlbEntry& entry = entries[found];
+    entry.lastUsed = accessClock;
+    frameNumber = entry.pageFrameNum + (int)(virtualPageNumber - entry.virtualPageNumber);
+    hits++;
+    return true;
+}
+
+void TLB:: insert(int asid, int64_t virtualPageNumber, int frameNumber, bool huge) {
+    accessClock++;
+
+    huge = huge && HUGE_SHIFT > 0;
+    if (huge) {
+        // store the huge page's first page and frame
+        int64_t offset = virtualPageNumber & (((int64_t)1 << HUGE_SHIFT) - 1);
+        virtualPageNumber -= offset;
+        frameNumber -= (int)offset;
+    }
+
+    tlbEntry& entry = entries[_chooseVictim(_setStart(huge ? virtualPageNumber >> HUGE_SHIFT : virtualPageNumber))];
+    entry.validBit = true;
+    entry.huge = huge;
+    entry.asid = asid;
+    entry.virtualPageNumber = virtualPageNumber;
+    entry.pageFrameNum = frameNumber;
+    entry.lastUsed = accessClock;
+    entry.insertedAt = accessClock;
+}
+
+void TLB:: invalidate(int asid, int64_t virtualPageNumber) {
+    // a page can be cached on its own and under a huge entry at once (right after promotion)
+    int found;
+    while ((found = _find(asid, virtualPageNumber)) != -1) {
+        entries[found].validBit = false;
+    }
+}
+
+void TLB:: flushASID(int asid) {
+    for (auto& entry : entries) {
+        if (entry.asid == asid) entry.validBit = false;
+    }
+    flushes++;
+}
+
+void TLB:: flush() {
+    for (auto& entry : entries) {
+        entry.validBit = false;
+    }
+    flushes++;
+}
+
+void TLB:: setHugePageShift(int shift) {
+    if (shift < 0) throw std::invalid_argument("Huge page shift must not be negative");
+
+    HUGE_SHIFT = shift;
+    flush();
+}
+
+void TLB:: resetStats() {
+    hits = 0;
+    misses = 0;
+    evictions = 0;
+    flushes = 0;
+}
+
+double TLB:: hitRate() const {
+    uint64_t lookups = hits + misses;
+    if (lookups == 0) return 0.0;
+    return (double)hits / lookups;
+}
+
+uint64_t TLB:: translationCycles() const {
+    // a miss pays for the failed lookup and the page table walk
+    return (hits + misses) * HIT_CYCLES + misses * MISS_CYCLES;
+}
+
+double TLB:: averageTranslationCycles() const {
+    uint64_t lookups = hits + misses;
+    if (lookups == 0) return 0.0;
+    return (double)translationCycles() / lookups;
+}
+
+int64_t TLB:: currentReach(int pageSize) const {
+    int64_t reach = 0;
+    for (const auto& entry : entries) {
+        if (!entry.validBit) continue;
+        reach += entry.huge ? (int64_t)pageSize << HUGE_SHIFT : pageSize;
+    }
+    return reach;
+}
+
+void TLB:: printStats(int pageSize) const {
+    std::cout << std::dec << std::noshowbase;
+    std::cout << "TLB: " << ENTRY_COUNT << " entries, " << ASSOCIATIVITY << "-way, "
+              << tlbReplacementName(replacement) << " replacement" << std::endl;
+    std::cout << "TLB reach: " << (long long)ENTRY_COUNT * pageSize << " bytes with base pages";
+    if (HUGE_SHIFT > 0) std::cout << ", " << ((long long)ENTRY_COUNT * pageSize << HUGE_SHIFT) << " with huge pages";
+    std::cout << ", currently cached: " << currentReach(pageSize) << " bytes" << std::endl;
+    std::cout << "Lookups: " << hits + misses << ", Hits: " << hits << ", Misses: " << misses << std::endl;
+    std::cout << "Hit rate: " << hitRate() * 100.0 << "%" << std::endl;
+    std::cout << "Evictions: " << evictions << ", Flushes: " << flushes << std::endl;
+    std::cout << "Simulated translation cost: " << translationCycles() << " cycles ("
+              << averageTranslationCycles() << " per access, " << HIT_CYCLES << " per hit, "
+              << HIT_CYCLES + MISS_CYCLES << " per miss)" << std::endl;
+}
+
+const char* tlbReplacementName(TLBReplacement policy) {
+    switch (policy) {
+        case TLBReplacement::LRU: return "LRU";
+        case TLBReplacement::FIFO: return "FIFO";
+        case TLBReplacement::RANDOM: return "Random";
+    }
+    return "Unknown";
+}
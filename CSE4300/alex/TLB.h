@@ -0,0 +1,104 @@
+#include <vector>
+#include <cstdint>
+#include <random>
+
+#ifndef TLB_H
+#define TLB_H
+
+// how a full TLB set picks the entry to throw out
+enum class TLBReplacement {
+    LRU,
+    FIFO,
+    RANDOM
+};
+
+struct tlbEntry {
+    bool validBit = false;
+    int asid = 0; // address space the translation belongs to
+    bool huge = false; // covers a whole huge page: virtualPageNumber/pageFrameNum are then its first page and frame
+    int64_t virtualPageNumber = -1;
+    int pageFrameNum = -1;
+    uint64_t lastUsed = 0; // for LRU
+    uint64_t insertedAt = 0; // for FIFO
+};
+
+// Set-associative translation lookaside buffer. Only caches VPN -> frame mappings,
+// MemoryManager still owns the page table and has to invalidate entries it evicts.
+class TLB {
+    private:
+        std::vector<tlbEntry> entries; // numSets * ASSOCIATIVITY entries, one set after another
+
+        int ENTRY_COUNT;
+        int ASSOCIATIVITY;
+        int numSets;
+        TLBReplacement replacement;
+
+        int HUGE_SHIFT = 0; // log2(base pages per huge page), 0 if huge pages are off
+
+        int HIT_CYCLES; // simulated cost of a TLB hit
+        int MISS_CYCLES; // simulated cost of a page table walk on a miss
+
+        uint64_t accessClock = 0; // ticks on every lookup/insert, stamps entries for LRU/FIFO
+        std::mt19937 randomGenerator; // for RANDOM replacement
+
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        uint64_t flushes = 0;
+
+        // index of the first entry in the set a VPN (or huge page number) maps to. internal use
+        int _setStart(int64_t virtualPageNumber) const;
+        // entry caching vpn, -1 if none. internal use
+        int _find(int asid, int64_t virtualPageNumber) const;
+        // pick the entry in a set to replace. returns entry index. internal use
+        int _chooseVictim(int setStart);
+
+    public:
+        // initialize TLB with default parameters (64 entries, 4-way, LRU, 1 cycle hit, 30 cycle miss)
+        TLB();
+        // initialize TLB with custom parameters: entries, associativity (entries must be a multiple), replacement, hit/miss cost in cycles
+        TLB(int num_entries, int associativity, TLBReplacement policy = TLBReplacement::LRU, int hit_cycles = 1, int miss_cycles = 30);
+
+        // look up a translation. returns true and sets frameNumber on a hit. counts the hit/miss
+        bool lookup(int asid, int64_t virtualPageNumber, int& frameNumber);
+        // cache a translation after a miss, replacing an entry if the set is full. a huge entry covers
+        // the whole huge page around virtualPageNumber (frames must be contiguous)
+        void insert(int asid, int64_t virtualPageNumber, int frameNumber, bool huge = false);
+
+        // drop the translation for one page (page evicted or deleted), including a huge entry covering it
+        void invalidate(int asid, int64_t virtualPageNumber);
+        // drop every translation for an address space
+        void flushASID(int asid);
+        // drop every translation
+        void flush();
+
+        // zero the hit/miss counters
+        void resetStats();
+
+        // size of huge pages as log2(base pages), 0 turns them off. drops every translation
+        void setHugePageShift(int shift);
+
+        int getEntryCount() const { return ENTRY_COUNT; }
+        int getAssociativity() const { return ASSOCIATIVITY; }
+        TLBReplacement getReplacement() const { return replacement; }
+        uint64_t getHits() const { return hits; }
+        uint64_t getMisses() const { return misses; }
+        uint64_t getEvictions() const { return evictions; }
+        uint64_t getFlushes() const { return flushes; }
+        // hits / lookups, 0 if nothing was looked up yet
+        double hitRate() const;
+        // total simulated translation cost in cycles
+        uint64_t translationCycles() const;
+        // average simulated cycles per translation
+        double averageTranslationCycles() const;
+        // bytes of memory covered by the entries currently cached (huge entries count their full size)
+        int64_t currentReach(int pageSize) const;
+
+        // print configuration and counters to std::cout; page size is used to report TLB reach
+        void printStats(int pageSize) const;
+};
+
+// name of a replacement policy, for printing
+const char* tlbReplacementName(TLBReplacement policy);
+
+#endif
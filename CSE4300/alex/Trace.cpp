@@ -0,0 +1,231 @@
+#include <chrono>
+#include <cctype>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_set>
+#include "Trace.h"
+
+const char TRACE_MAGIC[8] = {'V', 'M', 'T', 'R', 'A', 'C', 'E', '1'};
+
+// TraceReader
+
+TraceReader:: TraceReader(const std::string& path)
+: path(path), buffer(1 << 20){
+    file = std::fopen(path.c_str(), "rb");
+    if (!file) throw std::runtime_error("Cannot open trace file: " + path);
+
+    rewind();
+}
+
+TraceReader:: ~TraceReader() {
+    if (file) std::fclose(file);
+}
+
+bool TraceReader:: _fill() {
+    size_t leftover = bufferEnd - bufferStart;
+    std::memmove(buffer.data(), buffer.data() + bufferStart, leftover);
+    bufferStart = 0;
+    bufferEnd = leftover;
+
+    if (endOfFile) return false;
+    if (bufferEnd == buffer.size())
+        throw std::runtime_error("Trace line " + std::to_string(lineNumber + 1) + " is too long");
+
+    size_t got = std::fread(buffer.data() + bufferEnd, 1, buffer.size() - bufferEnd, file);
+    bufferEnd += got;
+    if (got == 0) endOfFile = true;
+    return got > 0;
+}
+
+void TraceReader:: rewind() {
+    std::fseek(file, 0, SEEK_SET);
+    bufferStart = 0;
+    bufferEnd = 0;
+    endOfFile = false;
+    lineNumber = 0;
+
+    while (bufferEnd < sizeof(TRACE_MAGIC) && _fill()) {}
+    binary = bufferEnd >= sizeof(TRACE_MAGIC) && std::memcmp(buffer.data(), TRACE_MAGIC, sizeof(TRACE_MAGIC)) == 0;
+    if (binary) bufferStart = sizeof(TRACE_MAGIC);
+}
+
+bool TraceReader:: next(traceRecord& record) {
+    return binary ? _nextBinary(record) : _nextText(record);
+}
+
+bool TraceReader:: _nextBinary(traceRecord& record) {
+    while (bufferEnd - bufferStart < 8) {
+        if (_fill()) continue;
+        if (bufferEnd != bufferStart) throw std::runtime_error("Trace ends in the middle of a record");
+        return false;
+    }
+
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(buffer.data() + bufferStart);
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++) value |= (uint64_t)bytes[i] << (8 * i);
+    bufferStart += 8;
+
+    record.write = (value >> 63) != 0;
+    record.virtualAddress = (int64_t)(value & ~((uint64_t)1 << 63));
+    return true;
+}
+
+bool TraceReader:: _nextText(traceRecord& record) {
+    while (true) {
+        const char* start = buffer.data() + bufferStart;
+        const char* end = buffer.data() + bufferEnd;
+        const char* newline = static_cast<const char*>(std::memchr(start, '\n', end - start));
+
+        if (!newline) {
+            // read on until the line is complete; the last line may not have a newline at all
+            if (_fill()) continue;
+            if (bufferStart == bufferEnd) return false;
+            newline = end;
+        }
+
+        bufferStart = newline - buffer.data();
+        if (bufferStart < bufferEnd) bufferStart++;
+        lineNumber++;
+
+        if (_parseLine(start, newline, record)) return true;
+    }
+}
+
+bool TraceReader:: _parseLine(const char* position, const char* end, traceRecord& record) {
+    auto blank = [](char c) { return c == ' ' || c == '\t' || c == '\r'; };
+
+    while (position < end && blank(*position)) position++;
+    if (position == end || *position == '#') return false;
+
+    // none of the access letters are hex digits, so there's no mixing them up with an address
+    record.write = false;
+    char type = (char)std::toupper((unsigned char)*position);
+    if (type == 'R' || type == 'L' || type == 'I' || type == 'W' || type == 'S' || type == 'M') {
+        record.write = type == 'W' || type == 'S' || type == 'M';
+        position++;
+        while (position < end && blank(*position)) position++;
+    }
+
+    if (end - position > 1 && position[0] == '0' && (position[1] == 'x' || position[1] == 'X')) position += 2;
+
+    uint64_t value = 0;
+    int digits = 0;
+    for (; position < end && std::isxdigit((unsigned char)*position); position++, digits++) {
+        if (value >> 59) throw std::runtime_error("Address too large on trace line " + std::to_string(lineNumber));
+        char c = *position;
+        value = (value << 4) | (uint64_t)(c <= '9' ? c - '0' : (std::tolower((unsigned char)c) - 'a' + 10));
+    }
+
+    if (digits == 0 || (position < end && !blank(*position) && *position != ',' && *position != '#'))
+        throw std::runtime_error("Bad reference on trace line " + std::to_string(lineNumber));
+
+    record.virtualAddress = (int64_t)value;
+    return true;
+}
+
+// TraceWriter
+
+TraceWriter:: TraceWriter(const std::string& path) {
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) throw std::runtime_error("Cannot create trace file: " + path);
+
+    buffer.reserve(1 << 20);
+    buffer.insert(buffer.end(), TRACE_MAGIC, TRACE_MAGIC + sizeof(TRACE_MAGIC));
+}
+
+TraceWriter:: ~TraceWriter() {
+    // errors can't be reported from here, call close() to find out about them
+    try {
+        close();
+    } catch (...) {
+    }
+}
+
+void TraceWriter:: _flush() {
+    if (!buffer.empty() && std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size())
+        throw std::runtime_error("Failed to write trace file");
+    buffer.clear();
+}
+
+void TraceWriter:: write(const traceRecord& record) {
+    if (!file) throw std::logic_error("Trace file is already closed");
+
+    uint64_t value = (uint64_t)record.virtualAddress | ((uint64_t)record.write << 63);
+    for (int i = 0; i < 8; i++) buffer.push_back((unsigned char)(value >> (8 * i)));
+
+    if (buffer.size() >= (1 << 20)) _flush();
+}
+
+void TraceWriter:: close() {
+    if (!file) return;
+
+    bool written = buffer.empty() || std::fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+    buffer.clear();
+    bool closed = std::fclose(file) == 0;
+    file = nullptr;
+
+    if (!written || !closed) throw std::runtime_error("Failed to write trace file");
+}
+
+// replay
+
+double replayResult:: missRatio() const {
+    if (references == 0) return 0.0;
+    return (double)(firstTouches + pageFaults) / references;
+}
+
+double replayResult:: referencesPerSecond() const {
+    if (seconds <= 0) return 0.0;
+    return references / seconds;
+}
+
+replayResult replayTrace(MemoryManager& mm, TraceReader& trace, bool pageNumbers, uint64_t limit) {
+    int pageShift = 0;
+    while ((1 << pageShift) < mm.getPageSize()) pageShift++;
+
+    replayResult result;
+    uint64_t faultsBefore = mm.getPageFaults();
+    uint64_t writesBefore = mm.getDiskWrites();
+    auto started = std::chrono::steady_clock::now();
+
+    traceRecord record;
+    while ((limit == 0 || result.references < limit) && trace.next(record)) {
+        int64_t address = record.virtualAddress;
+        if (pageNumbers) {
+            if (address > (INT64_MAX >> pageShift))
+                throw std::out_of_range("Trace reference " + std::to_string(result.references) + " is out of bounds");
+            address <<= pageShift;
+        }
+
+        if (!mm.isPageAllocated(address)) {
+            mm.allocatePage(address);
+            result.firstTouches++;
+        }
+
+        if (record.write) {
+            mm.writeVirtualMemory(address, (uint8_t)result.references);
+            result.writes++;
+        } else {
+            mm.readVirtualMemory(address);
+        }
+        result.references++;
+    }
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    result.pageFaults = mm.getPageFaults() - faultsBefore;
+    result.diskWrites = mm.getDiskWrites() - writesBefore;
+    return result;
+}
+
+std::vector<int64_t> optimalPageTrace(TraceReader& trace, int pageShift, bool pageNumbers, uint64_t limit) {
+    std::vector<int64_t> pages;
+    std::unordered_set<int64_t> seen;
+
+    traceRecord record;
+    for (uint64_t references = 0; (limit == 0 || references < limit) && trace.next(record); references++) {
+        int64_t vpn = pageNumbers ? record.virtualAddress : record.virtualAddress >> pageShift;
+        if (seen.insert(vpn).second) pages.push_back(vpn);
+        pages.push_back(vpn);
+    }
+    return pages;
+}
@@ -0,0 +1,103 @@
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdint>
+#include "MemoryManager.h"
+
+#ifndef TRACE_H
+#define TRACE_H
+
+// one reference of a page-access trace
+struct traceRecord {
+    int64_t virtualAddress = 0; // or a page number, if the trace holds those
+    bool write = false;
+};
+
+// first bytes of a binary trace
+extern const char TRACE_MAGIC[8];
+
+// Streams a page-reference trace from a file a chunk at a time, so traces larger than memory can be replayed.
+// Text traces have one reference per line: an optional access type (R, L or I read; W, S or M write) and then
+// the address in hex, "0x" optional. Anything after the address (like an access size) is ignored, and blank
+// lines and lines starting with # are skipped, so Valgrind lackey output reads as is.
+// Binary traces start with TRACE_MAGIC and hold one little-endian uint64 per reference: the address, with
+// bit 63 set for writes. The format is picked from the first bytes of the file.
+class TraceReader {
+    private:
+        std::FILE* file = nullptr;
+        std::string path;
+        bool binary = false;
+        std::vector<char> buffer;
+        size_t bufferStart = 0; // next unread byte
+        size_t bufferEnd = 0; // end of the bytes read so far
+        bool endOfFile = false;
+        uint64_t lineNumber = 0;
+
+        // move unread bytes to the front and read more. returns false if nothing new was read. internal use
+        bool _fill();
+        // next record of each format. internal use
+        bool _nextBinary(traceRecord& record);
+        bool _nextText(traceRecord& record);
+        // parse one text line; false for blank lines and comments. internal use
+        bool _parseLine(const char* position, const char* end, traceRecord& record);
+
+    public:
+        // open a trace, throws std::runtime_error if it can't be read
+        explicit TraceReader(const std::string& path);
+        ~TraceReader();
+        TraceReader(const TraceReader&) = delete;
+        TraceReader& operator=(const TraceReader&) = delete;
+
+        // read the next reference. returns false at the end of the trace, throws std::runtime_error on a bad line
+        bool next(traceRecord& record);
+        // go back to the first reference
+        void rewind();
+
+        bool isBinary() const { return binary; }
+        const std::string& getPath() const { return path; }
+};
+
+// writes references out in the binary format
+class TraceWriter {
+    private:
+        std::FILE* file = nullptr;
+        std::vector<unsigned char> buffer;
+
+        // write the buffer to the file. internal use
+        void _flush();
+
+    public:
+        explicit TraceWriter(const std::string& path);
+        ~TraceWriter();
+        TraceWriter(const TraceWriter&) = delete;
+        TraceWriter& operator=(const TraceWriter&) = delete;
+
+        void write(const traceRecord& record);
+        // flush and close, throws std::runtime_error if the data didn't make it to disk
+        void close();
+};
+
+// what one replay measured. faults are split into first touches (the page is allocated on its
+// first reference, a compulsory miss) and faults on pages that had been evicted
+struct replayResult {
+    uint64_t references = 0;
+    uint64_t writes = 0;
+    uint64_t firstTouches = 0;
+    uint64_t pageFaults = 0;
+    uint64_t diskWrites = 0;
+    double seconds = 0;
+
+    // (first touches + page faults) / references
+    double missRatio() const;
+    double referencesPerSecond() const;
+};
+
+// feed a trace through a MemoryManager's current address space, allocating each page on its first reference.
+// with pageNumbers the trace holds page numbers instead of addresses. stops after limit references (0 for all)
+replayResult replayTrace(MemoryManager& mm, TraceReader& trace, bool pageNumbers, uint64_t limit = 0);
+
+// page trace OptimalPolicy needs to follow a replay of the same trace: a page's first reference is
+// two steps (allocation, then the access), every other reference one
+std::vector<int64_t> optimalPageTrace(TraceReader& trace, int pageShift, bool pageNumbers, uint64_t limit = 0);
+
+#endif
@@ -0,0 +1,263 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
+#include "MemoryManager.h"
+#include "Trace.h"
+#include "StackDistance.h"
+
+// Batch driver: replays a page-reference trace through MemoryManager and reports the fault
+// rate, write-backs and replay speed, or a miss-ratio curve over several memory sizes. The LRU
+// curve can also come from one pass over the trace with the stack distance analyzer.
+
+struct replayOptions {
+    std::string tracePath;
+    std::string policy = "Clock";
+    std::string pageTable = "radix4";
+    int pageSize = 4096;
+    int64_t pageCount = (int64_t)1 << 36; // 48-bit addresses with 4K pages
+    int frames = 1024;
+    int tlbEntries = 64;
+    int tlbWays = 4;
+    int hugePages = 0;
+    bool pageNumbers = false;
+    uint64_t limit = 0;
+    std::vector<int> curveFrames; // memory sizes for the miss-ratio curve, empty for a single replay
+    std::string convertPath;
+    bool stats = false;
+    bool stackDistance = false; // one-pass LRU curve instead of replays
+    double sampleRate = 1.0;
+    size_t samplePages = 0;
+};
+
+std::string usage() {
+    return "Usage: TraceReplay <trace> [options]\n"
+           "  --policy NAME         page replacement policy (default Clock; OPT reads the trace twice)\n"
+           "  --frames N            physical memory frames (default 1024)\n"
+           "  --page-size N         bytes per page (default 4096)\n"
+           "  --pages N             virtual pages (default 2^36, a 48-bit space with 4K pages)\n"
+           "  --page-table NAME     flat, radix2, radix3, radix4 or inverted (default radix4)\n"
+           "  --tlb ENTRIES,WAYS    TLB size and associativity (default 64,4)\n"
+           "  --huge N              pages per huge page (default 0, off)\n"
+           "  --page-numbers        the trace holds page numbers instead of addresses\n"
+           "  --limit N             stop after N references\n"
+           "  --mrc F1,F2,...       replay once per frame count and print the miss-ratio curve\n"
+           "                        (with --stack-distance, just the sizes to print)\n"
+           "  --mrc LOW:HIGH        same, for every power of 2 frames from LOW to HIGH\n"
+           "  --stack-distance      LRU miss-ratio curve from one pass over the trace, no replays\n"
+           "  --sample-rate R       with --stack-distance, track only a fraction R of the pages (SHARDS)\n"
+           "  --sample-pages N      with --stack-distance, track at most N pages, lowering the rate as needed\n"
+           "  --convert OUT         write the trace to OUT in the binary format and exit\n"
+           "  --stats               print the MemoryManager statistics after the replay\n";
+}
+
+std::vector<int> parseFrameList(const std::string& list) {
+    std::vector<int> frames;
+
+    size_t colon = list.find(':');
+    if (colon != std::string::npos) {
+        int low = std::stoi(list.substr(0, colon));
+        int high = std::stoi(list.substr(colon + 1));
+        if (low <= 0 || high < low) throw std::invalid_argument("Bad frame range: " + list);
+        for (int64_t count = low; count <= high; count *= 2) frames.push_back((int)count);
+        return frames;
+    }
+
+    size_t start = 0;
+    while (start <= list.size()) {
+        size_t comma = list.find(',', start);
+        if (comma == std::string::npos) comma = list.size();
+        int count = std::stoi(list.substr(start, comma - start));
+        if (count <= 0) throw std::invalid_argument("Frame counts must be positive");
+        frames.push_back(count);
+        start = comma + 1;
+    }
+    return frames;
+}
+
+replayOptions parseOptions(int argc, char** argv) {
+    replayOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) throw std::invalid_argument("Missing value for " + argument);
+            return argv[++i];
+        };
+
+        if (argument == "--policy") options.policy = value();
+        else if (argument == "--frames") options.frames = std::stoi(value());
+        else if (argument == "--page-size") options.pageSize = std::stoi(value());
+        else if (argument == "--pages") options.pageCount = std::stoll(value());
+        else if (argument == "--page-table") options.pageTable = value();
+        else if (argument == "--tlb") {
+            std::string tlb = value();
+            size_t comma = tlb.find(',');
+            if (comma == std::string::npos) throw std::invalid_argument("--tlb takes ENTRIES,WAYS");
+            options.tlbEntries = std::stoi(tlb.substr(0, comma));
+            options.tlbWays = std::stoi(tlb.substr(comma + 1));
+        }
+        else if (argument == "--huge") options.hugePages = std::stoi(value());
+        else if (argument == "--page-numbers") options.pageNumbers = true;
+        else if (argument == "--limit") options.limit = std::stoull(value());
+        else if (argument == "--mrc") options.curveFrames = parseFrameList(value());
+        else if (argument == "--convert") options.convertPath = value();
+        else if (argument == "--stats") options.stats = true;
+        else if (argument == "--stack-distance") options.stackDistance = true;
+        else if (argument == "--sample-rate") options.sampleRate = std::stod(value());
+        else if (argument == "--sample-pages") options.samplePages = std::stoull(value());
+        else if (!argument.empty() && argument[0] == '-') throw std::invalid_argument("Unknown option: " + argument);
+        else if (options.tracePath.empty()) options.tracePath = argument;
+        else throw std::invalid_argument("Only one trace can be replayed at a time");
+    }
+
+    if (options.tracePath.empty()) throw std::invalid_argument("No trace given");
+    if (options.frames <= 0) throw std::invalid_argument("Frame count must be positive");
+    if (options.hugePages > 1 && (options.policy == "OPT" || options.policy == "opt"))
+        throw std::invalid_argument("OPT can't follow the filler pages huge pages add, turn one of them off");
+    if ((options.sampleRate != 1.0 || options.samplePages > 0) && !options.stackDistance)
+        throw std::invalid_argument("Sampling only applies to --stack-distance");
+
+    return options;
+}
+
+replayResult replayOnce(const replayOptions& options, int frames, TraceReader& trace) {
+    MemoryManager mm(options.pageSize, options.pageCount, frames, options.pageTable);
+    mm.setVerbose(false);
+    mm.setSimulateData(false); // only faults and write-backs are reported, the bytes don't matter
+    mm.configureTLB(options.tlbEntries, options.tlbWays);
+    mm.configureHugePages(options.hugePages);
+
+    // OPT has to know the whole trace before it starts
+    if (options.policy == "OPT" || options.policy == "opt") {
+        int pageShift = 0;
+        while ((1 << pageShift) < options.pageSize) pageShift++;
+
+        trace.rewind();
+        mm.setReplacementPolicy(std::make_unique<OptimalPolicy>(optimalPageTrace(trace, pageShift, options.pageNumbers, options.limit)));
+    } else {
+        mm.setReplacementPolicy(options.policy);
+    }
+
+    trace.rewind();
+    replayResult result = replayTrace(mm, trace, options.pageNumbers, options.limit);
+    if (options.stats) mm.printStats();
+    return result;
+}
+
+void convertTrace(const replayOptions& options, TraceReader& trace) {
+    TraceWriter writer(options.convertPath);
+    traceRecord record;
+    uint64_t references = 0;
+    while ((options.limit == 0 || references < options.limit) && trace.next(record)) {
+        writer.write(record);
+        references++;
+    }
+    writer.close();
+
+    std::cout << "Wrote " << references << " references to " << options.convertPath << std::endl;
+}
+
+void printReplay(const replayOptions& options, const TraceReader& trace, const replayResult& result) {
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Trace: " << trace.getPath() << " (" << (trace.isBinary() ? "binary" : "text") << "), "
+              << result.references << " references, " << result.writes << " writes" << std::endl;
+    std::cout << "Policy: " << options.policy << ", " << options.frames << " frames x " << options.pageSize
+              << " bytes, " << options.pageTable << " page table" << std::endl;
+    std::cout << "Page faults: " << result.firstTouches + result.pageFaults << " (" << result.firstTouches
+              << " first touches, " << result.pageFaults << " after eviction), miss ratio "
+              << result.missRatio() * 100 << "%" << std::endl;
+    std::cout << "Dirty write-backs: " << result.diskWrites << std::endl;
+    std::cout << "Replay: " << result.seconds << " s, " << std::setprecision(0) << result.referencesPerSecond()
+              << " references/s" << std::endl;
+}
+
+void printCurve(const replayOptions& options, TraceReader& trace) {
+    std::cout << "Miss-ratio curve for " << trace.getPath() << " with " << options.policy << ":" << std::endl;
+    std::cout << std::setw(10) << "Frames" << std::setw(14) << "Memory (KB)" << std::setw(14) << "Faults"
+              << std::setw(12) << "Miss ratio" << std::setw(14) << "Write-backs" << std::endl;
+
+    for (int frames : options.curveFrames) {
+        replayResult result = replayOnce(options, frames, trace);
+        std::cout << std::fixed << std::setprecision(4);
+        std::cout << std::setw(10) << frames << std::setw(14) << (int64_t)frames * options.pageSize / 1024
+                  << std::setw(14) << result.firstTouches + result.pageFaults << std::setw(12) << result.missRatio()
+                  << std::setw(14) << result.diskWrites << std::endl;
+    }
+}
+
+void printStackDistanceCurve(const replayOptions& options, TraceReader& trace) {
+    int pageShift = 0;
+    while ((1 << pageShift) < options.pageSize) pageShift++;
+
+    StackDistanceAnalyzer analyzer(options.sampleRate, options.samplePages);
+    traceRecord record;
+    auto started = std::chrono::steady_clock::now();
+    while ((options.limit == 0 || analyzer.getReferences() < options.limit) && trace.next(record))
+        analyzer.access(options.pageNumbers ? record.virtualAddress : record.virtualAddress >> pageShift);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "LRU miss-ratio curve for " << trace.getPath() << " from one pass, " << analyzer.getReferences()
+              << " references, " << std::setprecision(0) << analyzer.getDistinctPages() << " distinct pages";
+    if (analyzer.isSampled())
+        std::cout << " (estimated; sampled " << std::setprecision(4) << analyzer.getSamplingRate() * 100 << "% of pages, "
+                  << analyzer.getTrackedPages() << " tracked)";
+    std::cout << std::endl << std::setprecision(2) << "Analysis: " << seconds << " s" << std::endl;
+
+    // without --mrc, every power of 2 up to the size where only first references miss
+    std::vector<int> frames = options.curveFrames;
+    if (frames.empty())
+        for (int64_t count = 1; count <= std::max<int64_t>(1, (int64_t)analyzer.getDistinctPages()) * 2 && count <= INT32_MAX; count *= 2)
+            frames.push_back((int)count);
+
+    std::cout << std::setw(10) << "Frames" << std::setw(14) << "Memory (KB)" << std::setw(14) << "Faults"
+              << std::setw(12) << "Miss ratio" << std::endl;
+    bool unresolved = false;
+    for (int count : frames) {
+        std::cout << std::setw(10) << count << std::setw(14) << (int64_t)count * options.pageSize / 1024;
+        if (count < analyzer.getResolution()) {
+            std::cout << std::setw(14) << "-" << std::setw(12) << "-" << "  (below sampling resolution)" << std::endl;
+            unresolved = true;
+            continue;
+        }
+        std::cout << std::setprecision(0) << std::setw(14) << analyzer.misses(count)
+                  << std::setprecision(4) << std::setw(12) << analyzer.missRatio(count) << std::endl;
+    }
+    if (unresolved)
+        std::cout << "Sizes under " << analyzer.getResolution() << " frames (2/sampling rate) can't be estimated "
+                  << "from this sample; use a higher --sample-rate or --sample-pages for them" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    replayOptions options;
+    try {
+        options = parseOptions(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl << usage();
+        return 1;
+    }
+
+    try {
+        TraceReader trace(options.tracePath);
+
+        if (!options.convertPath.empty()) {
+            convertTrace(options, trace);
+        } else if (options.stackDistance) {
+            printStackDistanceCurve(options, trace);
+        } else if (!options.curveFrames.empty()) {
+            printCurve(options, trace);
+        } else {
+            replayResult result = replayOnce(options, options.frames, trace);
+            printReplay(options, trace, result);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Caught an exception: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,456 @@
+// Microbenchmarks for the scheduling hot paths.
+//
+// Measures getNextJob latency per policy across ready-queue sizes, end-to-end
+// engine throughput in virtual time, and heap allocations per operation.
+// Results are written as CSV and can be compared against a stored baseline.
+
+#include "job.h"
+#include "policy_registry.h"
+#include "scheduler_engine.h"
+#include "scheduling_policy.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// Sanitizers bring their own allocator, so the counting hooks below are left
+// out of sanitizer builds unless the build says otherwise.
+#ifndef CHRONOS_COUNT_ALLOCATIONS
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#define CHRONOS_COUNT_ALLOCATIONS 0
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer)
+#define CHRONOS_COUNT_ALLOCATIONS 0
+#endif
+#endif
+#endif
+#ifndef CHRONOS_COUNT_ALLOCATIONS
+#define CHRONOS_COUNT_ALLOCATIONS 1
+#endif
+
+// Every heap allocation in the process is counted so allocations per
+// operation can be reported next to latency.
+namespace {
+std::atomic<std::size_t> g_allocations{0};
+}
+
+#if CHRONOS_COUNT_ALLOCATIONS
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept {
+    std::free(ptr);
+}
+#endif
+
+namespace chronos {
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchOptions {
+    std::size_t max_queue_size = 1000000;
+    std::size_t engine_jobs = 1000;
+    int engine_cores = 4;
+    std::size_t dispatch_batch = 1; // EngineConfig::dispatch_batch for engine runs
+    double min_time_ms = 200.0;     // minimum measuring time per case
+    double max_call_ms = 1000.0;    // larger sizes are skipped once one call exceeds this
+    std::string output_path;        // CSV destination (empty = stdout)
+    std::string baseline_path;      // baseline CSV to compare against
+    double threshold = 0.10;        // allowed relative slowdown before flagging
+    std::vector<std::string> plugins;   // extra policies to benchmark
+};
+
+struct BenchResult {
+    std::string benchmark;
+    std::string policy;
+    std::size_t size = 0;
+    std::size_t iterations = 0;
+    double ns_per_op = 0.0;
+    double ops_per_sec = 0.0;
+    double allocs_per_op = 0.0;     // NaN when allocations are not counted
+};
+
+// Allocations per operation, or NaN in builds without the counting hooks
+double allocationsPerOp(std::size_t allocs, std::size_t ops) {
+    if (!CHRONOS_COUNT_ALLOCATIONS) {
+        return std::nan("");
+    }
+    return static_cast<double>(allocs) / static_cast<double>(ops);
+}
+
+std::string formatAllocs(double allocs_per_op, int precision) {
+    if (std::isnan(allocs_per_op)) {
+        return "n/a";
+    }
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(precision) << allocs_per_op;
+    return out.str();
+}
+
+struct BenchPolicy {
+    std::string name;
+    std::function<std::unique_ptr<ISchedulingPolicy>()> create;
+};
+
+// Every registered policy (built-ins plus loaded plugins), RR-style ones with quantum 2
+std::vector<BenchPolicy> benchPolicies() {
+    std::vector<BenchPolicy> policies;
+    for (const auto& name : PolicyRegistry::instance().names()) {
+        policies.push_back({name, [name] {
+            return PolicyRegistry::instance().create(name, PolicyParams{});
+        }});
+    }
+    return policies;
+}
+
+// Deterministic job set so runs are comparable against a baseline
+std::vector<Job> makeJobs(std::size_t count, float arrival_span) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> arrival_dist(0.0f, arrival_span);
+    std::uniform_real_distribution<float> burst_dist(1.0f, 10.0f);
+    std::uniform_int_distribution<int> priority_dist(1, 5);
+
+    std::vector<Job> jobs;
+    jobs.reserve(count);
+    for (std::size_t i = 1; i <= count; ++i) {
+        jobs.emplace_back(static_cast<int>(i), arrival_dist(gen), burst_dist(gen), priority_dist(gen));
+    }
+    return jobs;
+}
+
+// Time repeated getNextJob calls on a ready queue of the given size.
+// Returns false if a single call was slower than max_call_ms.
+bool benchGetNextJob(const BenchPolicy& factory, std::size_t size,
+                     const BenchOptions& options, BenchResult& result) {
+    const std::vector<Job> jobs = makeJobs(size, 10.0f);
+    JobQueue ready_queue(jobs.begin(), jobs.end());
+    for (auto& job : ready_queue) {
+        job.setState(JobState::READY);
+    }
+    auto policy = factory.create();
+
+    volatile int sink = 0;
+    std::size_t iterations = 0;
+    const std::size_t allocs_before = g_allocations.load();
+    const auto start = Clock::now();
+    double elapsed_ms = 0.0;
+
+    while (elapsed_ms < options.min_time_ms) {
+        // Check the clock in small batches to keep timer overhead out of the numbers
+        const std::size_t batch = iterations == 0 ? 1 : std::min<std::size_t>(iterations, 1024);
+        for (std::size_t i = 0; i < batch; ++i) {
+            if (Job* job = policy->getNextJob(ready_queue)) {
+                sink = job->getId();
+            }
+        }
+        iterations += batch;
+        elapsed_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        if (iterations == 1 && elapsed_ms > options.max_call_ms) {
+            break;
+        }
+    }
+    (void)sink;
+
+    const std::size_t allocs = g_allocations.load() - allocs_before;
+    result.benchmark = "get_next_job";
+    result.policy = factory.name;
+    result.size = size;
+    result.iterations = iterations;
+    result.ns_per_op = elapsed_ms * 1e6 / static_cast<double>(iterations);
+    result.ops_per_sec = 1e9 / result.ns_per_op;
+    result.allocs_per_op = allocationsPerOp(allocs, iterations);
+    return result.ns_per_op <= options.max_call_ms * 1e6;
+}
+
+// Full engine run in virtual time; one op is one dispatch of a job slice to a core.
+// "engine" uses the policy-specialized dispatch loop, "engine_virtual" the
+// ISchedulingPolicy one that plugins go through.
+BenchResult benchEngine(const BenchPolicy& factory, const BenchOptions& options,
+                        bool specialized) {
+    EngineConfig config;
+    config.time_scale_ms = 0.0f;
+    config.print_summary = false;
+    config.specialize_policies = specialized;
+    config.dispatch_batch = options.dispatch_batch;
+
+    std::vector<Job> jobs = makeJobs(options.engine_jobs, 10.0f);
+    auto policy = factory.create();
+    SchedulerEngine engine(config);
+
+    const std::size_t allocs_before = g_allocations.load();
+    const auto start = Clock::now();
+    ScheduleResult run = engine.run(std::move(jobs), *policy, options.engine_cores);
+    const double elapsed_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    const std::size_t allocs = g_allocations.load() - allocs_before;
+
+    const std::size_t dispatches = std::max<std::size_t>(1, run.context_switches);
+    BenchResult result;
+    result.benchmark = specialized ? "engine" : "engine_virtual";
+    result.policy = factory.name;
+    result.size = options.engine_jobs;
+    result.iterations = dispatches;
+    result.ns_per_op = elapsed_ms * 1e6 / static_cast<double>(dispatches);
+    result.ops_per_sec = 1e9 / result.ns_per_op;
+    result.allocs_per_op = allocationsPerOp(allocs, dispatches);
+    return result;
+}
+
+void writeCSV(std::ostream& os, const std::vector<BenchResult>& results) {
+    os << "benchmark,policy,size,iterations,ns_per_op,ops_per_sec,allocs_per_op\n";
+    os << std::fixed << std::setprecision(3);
+    for (const auto& r : results) {
+        os << r.benchmark << "," << r.policy << "," << r.size << "," << r.iterations << ","
+           << r.ns_per_op << "," << r.ops_per_sec << "," << formatAllocs(r.allocs_per_op, 3) << "\n";
+    }
+}
+
+using ResultKey = std::tuple<std::string, std::string, std::size_t>;
+
+bool readBaseline(const std::string& path, std::map<ResultKey, BenchResult>& baseline) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open baseline file: " << path << "\n";
+        return false;
+    }
+
+    std::string line;
+    std::getline(file, line); // header
+    while (std::getline(file, line)) {
+        std::istringstream row(line);
+        std::string field;
+        std::vector<std::string> fields;
+        while (std::getline(row, field, ',')) {
+            fields.push_back(field);
+        }
+        if (fields.size() != 7) {
+            continue;
+        }
+        try {
+            BenchResult r;
+            r.benchmark = fields[0];
+            r.policy = fields[1];
+            r.size = std::stoul(fields[2]);
+            r.iterations = std::stoul(fields[3]);
+            r.ns_per_op = std::stod(fields[4]);
+            r.ops_per_sec = std::stod(fields[5]);
+            r.allocs_per_op = fields[6] == "n/a" ? std::nan("") : std::stod(fields[6]);
+            baseline[ResultKey(r.benchmark, r.policy, r.size)] = r;
+        } catch (const std::exception&) {
+            std::cerr << "Warning: Skipping malformed baseline row: " << line << "\n";
+        }
+    }
+    return true;
+}
+
+// Returns the number of regressions found
+int compareWithBaseline(const std::vector<BenchResult>& results,
+                        const std::map<ResultKey, BenchResult>& baseline,
+                        double threshold) {
+    int regressions = 0;
+    std::cerr << "\nComparison against baseline (threshold " << threshold * 100.0 << "%)\n";
+    std::cerr << "benchmark      policy    size      base ns/op   ns/op        change   allocs\n";
+    for (const auto& r : results) {
+        auto it = baseline.find(ResultKey(r.benchmark, r.policy, r.size));
+        if (it == baseline.end()) {
+            continue;
+        }
+        const BenchResult& base = it->second;
+        const double change = base.ns_per_op > 0.0 ? (r.ns_per_op - base.ns_per_op) / base.ns_per_op : 0.0;
+        // Amortized container growth makes small fractions noisy; a new
+        // allocation on every operation shows up as +1.0. Uncounted (NaN)
+        // allocations never compare greater, so they are not flagged.
+        const bool slower = change > threshold;
+        const bool more_allocs = r.allocs_per_op > base.allocs_per_op + 0.5;
+
+        std::cerr << std::left << std::setw(15) << r.benchmark << std::setw(10) << r.policy
+                  << std::setw(10) << r.size << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(12) << base.ns_per_op << std::setw(12) << r.ns_per_op
+                  << std::setw(9) << change * 100.0 << "%"
+                  << std::setw(8) << formatAllocs(r.allocs_per_op, 2);
+        if (slower || more_allocs) {
+            std::cerr << "  REGRESSION" << (more_allocs ? " (allocations)" : "");
+            ++regressions;
+        }
+        std::cerr << "\n";
+    }
+    return regressions;
+}
+
+void printUsage() {
+    std::cout << "Usage: chronos_bench [OPTIONS]\n"
+              << "Options:\n"
+              << "  --max-size <N>          Largest ready-queue size for getNextJob (default 1000000)\n"
+              << "  --engine-jobs <N>       Jobs per end-to-end engine run (default 1000)\n"
+              << "  --engine-cores <N>      Cores for engine runs (default 4)\n"
+              << "  --dispatch-batch <K>    Jobs a core may take per lock hold in engine runs (default 1)\n"
+              << "  --min-time <MS>         Minimum measuring time per case (default 200)\n"
+              << "  --max-call <MS>         Skip larger sizes once one call exceeds this (default 1000)\n"
+              << "  --quick                 Small sizes and short timings (smoke runs)\n"
+              << "  --output <FILE>         Write CSV results to FILE instead of stdout\n"
+              << "  --baseline <FILE>       Compare against a CSV from an earlier run\n"
+              << "  --threshold <FRAC>      Allowed slowdown vs baseline (default 0.10)\n"
+              << "  --plugin <PATH>         Also benchmark policies from a plugin (repeatable)\n"
+              << "  --help, -h              Show this help message\n";
+}
+
+bool parseOptions(int argc, char* argv[], BenchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto next = [&](const char* flag) -> const char* {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: " << flag << " requires a value\n";
+                return nullptr;
+            }
+            return argv[++i];
+        };
+
+        try {
+            if (arg == "--max-size") {
+                const char* v = next("--max-size"); if (!v) return false;
+                options.max_queue_size = std::stoul(v);
+            } else if (arg == "--engine-jobs") {
+                const char* v = next("--engine-jobs"); if (!v) return false;
+                options.engine_jobs = std::stoul(v);
+            } else if (arg == "--engine-cores") {
+                const char* v = next("--engine-cores"); if (!v) return false;
+                options.engine_cores = std::stoi(v);
+            } else if (arg == "--dispatch-batch") {
+                const char* v = next("--dispatch-batch"); if (!v) return false;
+                options.dispatch_batch = std::stoul(v);
+            } else if (arg == "--min-time") {
+                const char* v = next("--min-time"); if (!v) return false;
+                options.min_time_ms = std::stod(v);
+            } else if (arg == "--max-call") {
+                const char* v = next("--max-call"); if (!v) return false;
+                options.max_call_ms = std::stod(v);
+            } else if (arg == "--quick") {
+                options.max_queue_size = 1000;
+                options.engine_jobs = 100;
+                options.min_time_ms = 20.0;
+            } else if (arg == "--output") {
+                const char* v = next("--output"); if (!v) return false;
+                options.output_path = v;
+            } else if (arg == "--baseline") {
+                const char* v = next("--baseline"); if (!v) return false;
+                options.baseline_path = v;
+            } else if (arg == "--threshold") {
+                const char* v = next("--threshold"); if (!v) return false;
+                options.threshold = std::stod(v);
+            } else if (arg == "--plugin") {
+                const char* v = next("--plugin"); if (!v) return false;
+                options.plugins.push_back(v);
+            } else if (arg == "--help" || arg == "-h") {
+                printUsage();
+                return false;
+            } else {
+                std::cerr << "Error: Unknown argument: " << arg << "\n";
+                return false;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Error: Invalid value for " << arg << "\n";
+            return false;
+        }
+    }
+
+    if (options.engine_jobs == 0 || options.engine_cores <= 0 || options.max_queue_size == 0 ||
+        options.dispatch_batch == 0) {
+        std::cerr << "Error: Sizes and core counts must be positive\n";
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+} // namespace chronos
+
+int main(int argc, char* argv[]) {
+    using namespace chronos;
+
+    BenchOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+    for (const auto& plugin : options.plugins) {
+        if (!PolicyRegistry::instance().loadPlugin(plugin)) {
+            return 1;
+        }
+    }
+
+    std::vector<BenchResult> results;
+    for (const auto& factory : benchPolicies()) {
+        for (std::size_t size = 10; size <= options.max_queue_size; size *= 10) {
+            BenchResult result;
+            const bool within_budget = benchGetNextJob(factory, size, options, result);
+            results.push_back(result);
+            std::cerr << "get_next_job " << std::left << std::setw(9) << factory.name
+                      << std::right << std::setw(8) << size << ": "
+                      << std::fixed << std::setprecision(1) << result.ns_per_op << " ns/op, "
+                      << formatAllocs(result.allocs_per_op, 2) << " allocs/op\n";
+            if (!within_budget) {
+                std::cerr << "  (skipping larger sizes for " << factory.name << ")\n";
+                break;
+            }
+        }
+    }
+
+    for (bool specialized : {true, false}) {
+        for (const auto& factory : benchPolicies()) {
+            BenchResult result = benchEngine(factory, options, specialized);
+            results.push_back(result);
+            std::cerr << std::left << std::setw(15) << result.benchmark << std::setw(9) << factory.name
+                      << std::right << std::setw(8) << result.size << ": "
+                      << std::fixed << std::setprecision(0) << result.ops_per_sec << " dispatches/s, "
+                      << formatAllocs(result.allocs_per_op, 2) << " allocs/dispatch\n";
+        }
+    }
+
+    if (options.output_path.empty()) {
+        writeCSV(std::cout, results);
+    } else {
+        std::ofstream file(options.output_path);
+        if (!file.is_open()) {
+            std::cerr << "Error: Could not open file for writing: " << options.output_path << "\n";
+            return 1;
+        }
+        writeCSV(file, results);
+    }
+
+    if (!options.baseline_path.empty()) {
+        std::map<ResultKey, BenchResult> baseline;
+        if (!readBaseline(options.baseline_path, baseline)) {
+            return 1;
+        }
+        const int regressions = compareWithBaseline(results, baseline, options.threshold);
+        if (regressions > 0) {
+            std::cerr << regressions << " regression(s) against baseline\n";
+            return 2;
+        }
+        std::cerr << "No regressions against baseline\n";
+    }
+
+    return 0;
+}
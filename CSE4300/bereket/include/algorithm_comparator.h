@@ -2,8 +2,9 @@
 #define CHRONOS_ALGORITHM_COMPARATOR_H
 
 #include "job.h"
+#include "job_graph.h"
 #include "scheduling_policy.h"
-#include "cli_parser.h"
+#include "scheduler_engine.h"
 
 #include <memory>
 #include <vector>
@@ -13,22 +14,22 @@ namespace chronos {
 // Runs all scheduling algorithms on the same job set and compares results
 class AlgorithmComparator {
 public:
-    // Run all algorithms (FCFS, SJF, Priority, RR) on the same job set
-    static bool compareAll(std::vector<Job> jobs, int num_cores, int quantum = 2);
+    // Run every policy in the PolicyRegistry (built-ins and plugins) on the same job set
+    static bool compareAll(std::vector<Job> jobs, int num_cores, int quantum = 2,
+                           const EngineConfig& config = EngineConfig(),
+                           const JobGraph& graph = JobGraph());
     
     // Print comparison summary table
     static void printComparisonSummary();
 
 private:
-    // Create a policy instance for the given algorithm
-    static std::unique_ptr<ISchedulingPolicy> createPolicy(
-        SchedulingAlgorithm algo, int quantum = 2);
-    
     // Run a single algorithm and write results
     static bool runAndWriteAlgorithm(
         std::vector<Job> jobs,
         std::unique_ptr<ISchedulingPolicy> policy,
         int num_cores,
+        const EngineConfig& config,
+        const JobGraph& graph,
         const std::string& output_dir = "output");
 };
 
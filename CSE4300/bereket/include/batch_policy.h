@@ -0,0 +1,101 @@
+#ifndef CHRONOS_BATCH_POLICY_H
+#define CHRONOS_BATCH_POLICY_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace chronos {
+
+// Forward declaration
+class BatchSimulator;
+
+// Space-sharing policy for parallel jobs (see BatchSimulator). Unlike an
+// ISchedulingPolicy, which hands one job to one core, a batch policy
+// decides which waiting jobs get a block of cores now.
+class IBatchPolicy {
+public:
+    virtual ~IBatchPolicy() = default;
+
+    virtual std::string getName() const = 0;
+
+    // Called whenever jobs arrive or cores free up. Inspect the simulator's
+    // waiting queue and free cores and start() whatever should run now.
+    virtual void schedule(BatchSimulator& sim) = 0;
+};
+
+// Strict gang scheduling: jobs start in arrival order, each only once all of
+// its threads can start together. A wide job at the head blocks the queue.
+class GangPolicy : public IBatchPolicy {
+public:
+    std::string getName() const override { return "Gang"; }
+    void schedule(BatchSimulator& sim) override;
+};
+
+// Relaxed co-scheduling: the head job may start once min_fraction of its
+// threads have cores; its remaining threads take the next cores that free
+// up, ahead of any waiting job. Threads that start late finish late.
+class RelaxedCoschedulingPolicy : public IBatchPolicy {
+public:
+    explicit RelaxedCoschedulingPolicy(float min_fraction = 0.5f);
+
+    std::string getName() const override { return "Relaxed"; }
+    void schedule(BatchSimulator& sim) override;
+
+private:
+    float min_fraction_;
+};
+
+// Gang scheduling with first-fit backfilling: any waiting job that fits in
+// the free cores starts, in arrival order. Nothing is reserved for the
+// jobs it skips, so wide jobs can starve under a stream of narrow ones.
+class FirstFitBackfillPolicy : public IBatchPolicy {
+public:
+    std::string getName() const override { return "Backfill"; }
+    void schedule(BatchSimulator& sim) override;
+};
+
+// EASY backfilling: jobs start in arrival order; when the head job does not
+// fit it gets a reservation at the earliest time enough cores free up
+// (judged from runtime estimates), and later jobs may jump ahead only if
+// they do not delay that reservation.
+//
+// Estimates are multiplied by estimate_factor before planning, so the
+// inflation users (or the site) apply to their estimates can be tuned.
+class EasyBackfillPolicy : public IBatchPolicy {
+public:
+    explicit EasyBackfillPolicy(float estimate_factor = 1.0f);
+
+    std::string getName() const override { return "EASY"; }
+    void schedule(BatchSimulator& sim) override;
+
+private:
+    float estimate_factor_;
+};
+
+// Conservative backfilling: every waiting job gets a reservation, in
+// arrival order, in a profile of future free cores; a job jumps ahead only
+// if it delays none of them. Reservations are rebuilt at every scheduling
+// point, so jobs that finish early pull the later ones forward.
+class ConservativeBackfillPolicy : public IBatchPolicy {
+public:
+    explicit ConservativeBackfillPolicy(float estimate_factor = 1.0f);
+
+    std::string getName() const override { return "Conservative"; }
+    void schedule(BatchSimulator& sim) override;
+
+private:
+    float estimate_factor_;
+};
+
+// Batch policy names accepted by createBatchPolicy(), in comparison order
+std::vector<std::string> batchPolicyNames();
+
+// Create a batch policy by name (case-insensitive); nullptr if unknown.
+// estimate_factor scales runtime estimates for the reservation policies.
+std::unique_ptr<IBatchPolicy> createBatchPolicy(const std::string& name,
+                                                float estimate_factor = 1.0f);
+
+}
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef CHRONOS_BATCH_SIMULATOR_H
+#define CHRONOS_BATCH_SIMULATOR_H
+
+#include "batch_policy.h"
+#include "job.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace chronos {
+
+struct BatchConfig {
+    int num_cores = 16;
+    std::size_t num_jobs = 1000;
+    float load = 0.8f;              // offered load as a fraction of machine capacity
+    std::uint32_t seed = 42;
+    std::string policy = "gang";    // see batchPolicyNames()
+    float estimate_factor = 1.0f;   // multiplies runtime estimates in EASY/conservative
+    float max_overestimate = 3.0f;  // user estimates are runtime x U(1, max_overestimate)
+    float slowdown_bound = 1.0f;    // runtimes below this count as this long in bounded slowdown
+};
+
+struct BatchResult {
+    bool ok = false;
+    std::string policy;
+    int num_cores = 0;
+    std::vector<Job> completed_jobs;    // in completion order
+    std::size_t skipped_jobs = 0;       // wider than the machine, never started
+    float makespan = 0.0f;
+    double busy_time = 0.0;             // core-seconds spent executing threads
+
+    float averageWaitingTime() const;
+    float averageTurnaroundTime() const;
+    float maxWaitingTime() const;
+    float utilization() const;
+
+    // Mean of max(1, turnaround / max(runtime, bound)) over completed jobs
+    float averageBoundedSlowdown(float bound) const;
+};
+
+// A started parallel job as batch policies see it
+struct BatchAllocation {
+    Job job;
+    int cores = 0;              // cores currently held by its threads
+    int threads_pending = 0;    // threads still waiting for a core (relaxed only)
+    int threads_done = 0;
+};
+
+// Space-shared machine for parallel jobs, simulated as a discrete-event
+// system in virtual time on the calling thread. A job with N threads holds
+// N cores (one per thread) and each thread runs for the job's burst time;
+// the job finishes with its last thread. Which jobs start when is up to an
+// IBatchPolicy, which is consulted after every arrival and completion.
+class BatchSimulator {
+public:
+    explicit BatchSimulator(BatchConfig config);
+
+    // Generate the configured workload and run it under config.policy
+    BatchResult run();
+
+    // Run the given jobs under a policy
+    BatchResult run(std::vector<Job> jobs, IBatchPolicy& policy);
+
+    static void printSummary(const BatchResult& result, const BatchConfig& config);
+
+    // Run the same workload under every batch policy and print a comparison
+    static bool comparePolicies(const BatchConfig& config);
+
+    // Parallel jobs with power-of-two thread counts up to num_cores, Poisson
+    // arrivals at the configured load and over-estimated runtimes
+    static std::vector<Job> generateWorkload(const BatchConfig& config);
+
+    // --- Scheduling-point view for policies ---
+    float now() const { return now_; }
+    int totalCores() const { return config_.num_cores; }
+    int freeCores() const { return free_cores_; }
+
+    // Jobs that have arrived and not started, in arrival order
+    const std::vector<Job>& waiting() const { return waiting_; }
+
+    // Started jobs that have not finished, in start order
+    const std::vector<BatchAllocation>& running() const { return running_; }
+
+    // Start threads of waiting job `index` on `cores` free cores now. Fewer
+    // cores than threads leaves the rest pending until cores free up.
+    // Invalidates indices after `index`. Returns false if it does not fit.
+    bool start(std::size_t index, int cores);
+
+private:
+    // Thread completion: (finish time, job id), earliest first
+    using ThreadEvent = std::pair<float, int>;
+
+    void finishThread(int job_id, BatchResult& result);
+    void startPendingThreads();
+
+    BatchConfig config_;
+    float now_ = 0.0f;
+    int free_cores_ = 0;
+    std::vector<Job> waiting_;
+    std::vector<BatchAllocation> running_;
+    std::priority_queue<ThreadEvent, std::vector<ThreadEvent>, std::greater<ThreadEvent>> events_;
+};
+
+}
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef CHRONOS_CHECKPOINT_H
+#define CHRONOS_CHECKPOINT_H
+
+#include "job.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace chronos {
+
+// Appends trivially copyable values to a byte buffer (native byte order)
+class ByteWriter {
+public:
+    template <typename T>
+    void put(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "ByteWriter needs trivially copyable types");
+        const auto* raw = reinterpret_cast<const std::uint8_t*>(&value);
+        bytes_.insert(bytes_.end(), raw, raw + sizeof(T));
+    }
+
+    const std::vector<std::uint8_t>& bytes() const { return bytes_; }
+    std::vector<std::uint8_t> take() { return std::move(bytes_); }
+
+private:
+    std::vector<std::uint8_t> bytes_;
+};
+
+// Reads values written by ByteWriter; get() fails instead of reading past the end
+class ByteReader {
+public:
+    ByteReader(const std::uint8_t* data, std::size_t size)
+        : data_(data), size_(size), pos_(0) {}
+
+    explicit ByteReader(const std::vector<std::uint8_t>& bytes)
+        : ByteReader(bytes.data(), bytes.size()) {}
+
+    template <typename T>
+    bool get(T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "ByteReader needs trivially copyable types");
+        if (size_ - pos_ < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, data_ + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return true;
+    }
+
+    bool atEnd() const { return pos_ == size_; }
+
+private:
+    const std::uint8_t* data_;
+    std::size_t size_;
+    std::size_t pos_;
+};
+
+// Everything needed to continue a SchedulerEngine run. Taken at a slice
+// boundary, so no job is mid-execution: each one is pending, ready or completed.
+struct SimulationSnapshot {
+    std::string policy_name;                // ISchedulingPolicy::getName() of the run
+    std::vector<std::uint8_t> policy_state; // ISchedulingPolicy::saveState()
+    int num_cores = 1;
+    float simulation_start = 0.0f;
+    float current_time = 0.0f;              // scheduler's admission clock
+    float idle_time = 0.0f;
+    std::uint64_t context_switches = 0;
+    std::uint64_t rejected_jobs = 0;        // bounded-queue accounting (see EngineConfig)
+    std::uint64_t shed_jobs = 0;
+    float wasted_time = 0.0f;
+    std::vector<float> core_clock;
+    std::vector<float> core_busy_time;
+    std::vector<Job> pending;               // not yet admitted, in arrival order
+    std::vector<Job> ready;                 // ready queue, in queue order
+    std::vector<Job> completed;             // in completion order
+};
+
+// Write a snapshot to path. The file is written next to path and renamed
+// over it, so an interrupted write never clobbers the previous checkpoint.
+bool saveSnapshot(const SimulationSnapshot& snapshot, const std::string& path);
+
+// Read a snapshot written by saveSnapshot(); prints an error and returns
+// nothing if the file is missing, truncated, corrupt or from another version
+std::optional<SimulationSnapshot> loadSnapshot(const std::string& path);
+
+}
+
+#endif
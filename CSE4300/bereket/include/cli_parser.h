@@ -7,20 +7,31 @@
 
 namespace chronos {
 
-// supported scheduling algorithms
-enum class SchedulingAlgorithm {
-    FCFS,        // First Come First Serve
-    SJF,         // Shortest Job First
-    PRIORITY,    // Priority Scheduling
-    RR,          // Round Robin
-};
-
 struct CLIOptions {
-    SchedulingAlgorithm algorithm = SchedulingAlgorithm::FCFS;
+    std::string algorithm = "FCFS";     // canonical PolicyRegistry name
     int num_cores = 1;
     int num_jobs = 0;
     std::optional<int> quantum = 1;
     bool compare_all = false;
+    float time_scale_ms = 1000.0f;  // wall ms per simulated second (0 = virtual time)
+    std::string metrics_socket;     // live snapshot socket (empty = disabled)
+    int metrics_interval_ms = 1000;
+    int dispatch_batch = 1;             // jobs a core may take per ready-queue lock hold
+    int queue_capacity = 0;             // ready queue bound (0 = unbounded)
+    std::string overflow_policy = "reject";     // what a full ready queue does with arrivals
+    std::vector<std::string> plugins;   // shared objects loaded into the PolicyRegistry
+    std::string checkpoint_path;        // checkpoint file (empty = disabled)
+    int checkpoint_interval_ms = 0;     // wall ms between checkpoints (0 = only on SIGTERM/SIGINT)
+    std::string resume_path;            // checkpoint to continue from
+    int cluster_machines = 0;           // > 0 switches to the sharded cluster simulator
+    int cluster_shards = 1;             // shard processes for cluster mode
+    float cluster_load = 0.8f;          // offered load as a fraction of cluster capacity
+    float cluster_epoch = 1.0f;         // simulated seconds between shard synchronizations
+    std::string balancer = "round-robin";   // cluster load balancer
+    bool compare_balancers = false;
+    std::string batch_policy;           // non-empty switches to the parallel batch simulator
+    float estimate_factor = 1.0f;       // runtime estimate inflation for backfilling policies
+    bool dag = false;                   // generate jobs with random predecessor dependencies
 
     bool is_valid = false;
 };
@@ -29,13 +40,14 @@ class CLIParser {
 public:
     static CLIOptions parse(int argc, char* argv[]);
     static void printOptions(const CLIOptions& options);
-    static std::string algorithmToString(const SchedulingAlgorithm& algorithm);
-    static std::optional<SchedulingAlgorithm> stringToAlgorithm(const std::string& str);
 
 private:
     // Helper: Extract integer value from argument
     static bool parseIntArg(const std::string& arg, const std::string& flag, int& value);
     
+    // Helper: Comma-separated list of registered policy names
+    static std::string policyList();
+
     // Helper: Validate parsed options
     static bool validateOptions(const CLIOptions& options);
 
@@ -0,0 +1,80 @@
+#ifndef CHRONOS_CLUSTER_SIMULATOR_H
+#define CHRONOS_CLUSTER_SIMULATOR_H
+
+#include "load_balancer.h"
+#include "machine_model.h"
+#include "scheduling_policy.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace chronos {
+
+struct ClusterConfig {
+    int num_machines = 100;
+    int cores_per_machine = 4;
+    int num_shards = 1;             // worker processes; machines are split evenly
+    std::size_t num_jobs = 10000;
+    float load = 0.8f;              // offered load as a fraction of cluster capacity
+    float epoch = 1.0f;             // simulated seconds between shard synchronizations
+    std::uint32_t seed = 42;
+    std::size_t inbox_capacity = 1 << 16;   // jobs per shard per epoch
+    std::string balancer = "round-robin";   // see loadBalancerNames()
+
+    // Creates the per-core policy of each machine (called in the shard processes)
+    std::function<std::unique_ptr<ISchedulingPolicy>()> policy_factory;
+};
+
+struct ClusterResult {
+    bool ok = false;
+    std::string balancer;
+    int num_machines = 0;
+    int num_shards = 0;
+    std::uint64_t epochs = 0;
+    double wall_seconds = 0.0;
+    float makespan = 0.0f;
+    MachineStats totals{};
+
+    // Per-machine imbalance: busiest machine's busy time over the mean, and
+    // the longest queue over the mean queue averaged over epochs (1.0 = even)
+    double busy_imbalance = 0.0;
+    double queue_imbalance = 0.0;
+
+    double averageWaitingTime() const;
+    double averageTurnaroundTime() const;
+    double utilization(int cores_per_machine) const;
+};
+
+// Simulates a cluster of machines, each running its own per-core policy,
+// behind a global dispatcher (an ILoadBalancer) that routes arriving jobs
+// to machines.
+//
+// Machines are partitioned across forked shard processes that share one
+// anonymous memory mapping with the coordinator (this process). Time
+// advances in conservative epochs: the coordinator routes every job that
+// arrives in the epoch into per-shard inboxes using machine state published
+// at the end of the previous epoch, then all shards simulate their machines
+// up to the epoch boundary independently. Machines never interact within
+// an epoch, so shards need no other synchronization; the epoch length only
+// bounds how stale the dispatcher's view of the machines is.
+class ClusterSimulator {
+public:
+    explicit ClusterSimulator(ClusterConfig config);
+
+    ClusterResult run();
+
+    static void printSummary(const ClusterResult& result, const ClusterConfig& config);
+
+    // Run the same workload under every load balancer and print a comparison
+    static bool compareBalancers(const ClusterConfig& config);
+
+private:
+    ClusterConfig config_;
+};
+
+}
+
+#endif
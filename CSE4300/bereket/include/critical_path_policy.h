@@ -0,0 +1,30 @@
+#ifndef CHRONOS_CRITICAL_PATH_POLICY_H
+#define CHRONOS_CRITICAL_PATH_POLICY_H
+
+#include "scheduling_policy.h"
+#include <string>
+
+namespace chronos {
+
+// HEFT-style list scheduling on identical cores (non-preemptive): always
+// run the ready job with the highest upward rank, i.e. the one heading the
+// longest remaining dependency chain. Ranks come from
+// JobGraph::assignUpwardRanks(); for independent jobs a job's rank is its
+// burst, so this degrades to longest-job-first.
+class CriticalPathPolicy final : public ISchedulingPolicy {
+public:
+    ~CriticalPathPolicy() override = default;
+
+    // Highest upward rank --> tie-break by arrival, then job id.
+    Job* getNextJob(JobQueue& ready_queue) override;
+
+    void onJobCompletion(Job* /*completed_job*/, float /*current_time*/) override {}
+
+    std::string getName() const override { return "CriticalPath"; }
+
+    bool isPreemptive() const override { return false; }
+};
+
+}
+
+#endif
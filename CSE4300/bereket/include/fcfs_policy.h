@@ -13,7 +13,7 @@ public:
 
     // Selects the job with the earliest arrival time.
     // Tie-breaker: smaller job_id.
-    Job* getNextJob(std::vector<Job>& ready_queue) override;
+    Job* getNextJob(JobQueue& ready_queue) override;
 
     // FCFS has no special completion handling --> just moves on to the next one.
     void onJobCompletion(Job* /*completed_job*/, float /*current_time*/) override {}
@@ -3,6 +3,8 @@
 
 #include <string>
 #include <iostream>
+#include <memory_resource>
+#include <vector>
 
 namespace chronos {
 
@@ -27,6 +29,10 @@ public:
     float getBurstTime() const { return burst_time; }
     float getRemainingTime() const { return remaining_time; }
     int getPriority() const { return priority; }
+    int getNumThreads() const { return num_threads; }
+    float getRuntimeEstimate() const { return runtime_estimate; }
+    float getReadyTime() const { return ready_time; }
+    float getUpwardRank() const { return upward_rank; }
     JobState getState() const { return state; }
     float getStartTime() const { return start_time; }
     float getFinishTime() const { return finish_time; }
@@ -38,6 +44,10 @@ public:
     void setStartTime(float time) { start_time = time; }
     void setFinishTime(float time) { finish_time = time; }
     void setRemainingTime(float time) { remaining_time = time; }
+    void setNumThreads(int threads) { num_threads = threads < 1 ? 1 : threads; }
+    void setRuntimeEstimate(float estimate) { runtime_estimate = estimate; }
+    void setReadyTime(float time) { ready_time = time; }
+    void setUpwardRank(float rank) { upward_rank = rank; }
     
     // Update calculated metrics (waiting and turnaround times)
     void calculateMetrics();
@@ -66,6 +76,10 @@ private:
     float burst_time;        // Total CPU time required
     float remaining_time;    // Remaining CPU time (for preemptive algorithms)
     int priority;            // Priority value (higher = more priority)
+    int num_threads;         // Cores needed simultaneously (1 = sequential job)
+    float runtime_estimate;  // User-supplied runtime guess (defaults to burst_time)
+    float ready_time;        // Earliest start: arrival, or when the last predecessor finished
+    float upward_rank;       // Longest dependency chain from here to an exit job (see JobGraph)
     
     JobState state;          // Current execution state
     
@@ -77,6 +91,10 @@ private:
     float turnaround_time;   // Total time in system (finish_time - arrival_time)
 };
 
+// Queue of jobs whose storage comes from a run-scoped memory resource
+// (see RunArena); defaults to the global heap when no resource is given.
+using JobQueue = std::pmr::vector<Job>;
+
 // Helper to convert JobState to string
 std::string stateToString(JobState state);
 
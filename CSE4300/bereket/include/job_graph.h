@@ -0,0 +1,68 @@
+#ifndef CHRONOS_JOB_GRAPH_H
+#define CHRONOS_JOB_GRAPH_H
+
+#include "job.h"
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace chronos {
+
+// Precedence constraints between jobs of one workload, by job id: a job may
+// not start before all of its predecessors have finished.
+class JobGraph {
+public:
+    // job_id depends on predecessor_id; duplicate edges are ignored
+    void addDependency(int job_id, int predecessor_id);
+
+    const std::vector<int>& predecessors(int job_id) const;
+    const std::vector<int>& successors(int job_id) const;
+
+    bool empty() const { return edge_count_ == 0; }
+    std::size_t edgeCount() const { return edge_count_; }
+
+    // Check that every edge names a job in `jobs`, ids are unique and there
+    // are no cycles; prints the first problem found
+    bool validate(const std::vector<Job>& jobs) const;
+
+    // Set each job's upward rank (HEFT with no communication cost): its
+    // burst plus the largest rank among its successors. Returns the
+    // critical path length, a lower bound on the makespan. Requires validate().
+    float assignUpwardRanks(std::vector<Job>& jobs) const;
+
+private:
+    std::unordered_map<int, std::vector<int>> predecessors_;
+    std::unordered_map<int, std::vector<int>> successors_;
+    std::size_t edge_count_ = 0;
+};
+
+// Run-time side of a JobGraph: holds jobs back until their predecessors have
+// finished, then releases them with their ready time set to the latest
+// predecessor finish.
+class DependencyTracker {
+public:
+    explicit DependencyTracker(const JobGraph& graph);
+
+    // Keep the job if it still has unfinished predecessors; false if it can
+    // be admitted as is
+    bool hold(Job& job);
+
+    // Record a finished job and append any successors it unblocked to released
+    void complete(const Job& job, std::vector<Job>& released);
+
+    std::size_t heldCount() const { return held_.size(); }
+
+private:
+    struct Held {
+        Job job;
+        std::size_t unfinished;
+    };
+
+    const JobGraph& graph_;
+    std::unordered_map<int, Held> held_;
+};
+
+}
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef CHRONOS_LATENCY_HISTOGRAM_H
+#define CHRONOS_LATENCY_HISTOGRAM_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace chronos {
+
+// Fixed-size log-scale histogram of simulated latencies (seconds).
+// Plain data, so it can live in shared memory and be merged across
+// processes. Quantiles are accurate to one bucket (about 12%).
+struct LatencyHistogram {
+    static constexpr int BUCKETS_PER_DECADE = 20;
+    static constexpr int MIN_EXPONENT = -3;     // 1 ms
+    static constexpr int MAX_EXPONENT = 7;      // ~116 days
+    static constexpr int NUM_BUCKETS = (MAX_EXPONENT - MIN_EXPONENT) * BUCKETS_PER_DECADE + 1;
+
+    std::uint64_t counts[NUM_BUCKETS];
+    std::uint64_t total;
+
+    void clear() {
+        for (auto& count : counts) {
+            count = 0;
+        }
+        total = 0;
+    }
+
+    void record(float value) {
+        ++counts[bucketFor(value)];
+        ++total;
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (int i = 0; i < NUM_BUCKETS; ++i) {
+            counts[i] += other.counts[i];
+        }
+        total += other.total;
+    }
+
+    // Upper edge of the bucket holding the q-th sample (nearest rank)
+    float quantile(double q) const {
+        if (total == 0) {
+            return 0.0f;
+        }
+        std::uint64_t rank = static_cast<std::uint64_t>(q * static_cast<double>(total));
+        if (rank >= total) {
+            rank = total - 1;
+        }
+        std::uint64_t seen = 0;
+        for (int i = 0; i < NUM_BUCKETS; ++i) {
+            seen += counts[i];
+            if (seen > rank) {
+                return upperEdge(i);
+            }
+        }
+        return upperEdge(NUM_BUCKETS - 1);
+    }
+
+private:
+    static int bucketFor(float value) {
+        if (!(value > 0.0f)) {
+            return 0;
+        }
+        const double position = (std::log10(static_cast<double>(value)) - MIN_EXPONENT) * BUCKETS_PER_DECADE;
+        if (position < 0.0) {
+            return 0;
+        }
+        const int bucket = static_cast<int>(std::ceil(position));
+        return bucket < NUM_BUCKETS ? bucket : NUM_BUCKETS - 1;
+    }
+
+    static float upperEdge(int bucket) {
+        return static_cast<float>(std::pow(10.0, MIN_EXPONENT + static_cast<double>(bucket) / BUCKETS_PER_DECADE));
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef CHRONOS_LIVE_METRICS_H
+#define CHRONOS_LIVE_METRICS_H
+
+#include "job.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace chronos {
+
+// Forward declaration
+class WorkerPoolBase;
+
+// Point-in-time view of a simulation that is still running
+struct MetricsSnapshot {
+    double wall_seconds = 0.0;      // wall-clock time since the run started
+    float sim_time = 0.0f;          // furthest simulated time reached by any core
+    std::size_t jobs_total = 0;
+    std::size_t jobs_completed = 0;
+    std::size_t queue_depth = 0;    // jobs currently waiting in the ready queue
+    double throughput = 0.0;        // completed jobs per wall-clock second
+    std::vector<float> core_busy;   // busy fraction per core (0.0 to 1.0)
+
+    // Quantiles over all jobs completed so far
+    float turnaround_p50 = 0.0f;
+    float turnaround_p95 = 0.0f;
+    float turnaround_p99 = 0.0f;
+    float waiting_p50 = 0.0f;
+    float waiting_p95 = 0.0f;
+    float waiting_p99 = 0.0f;
+
+    // Serialize as a single line of JSON (no trailing newline)
+    std::string toJson() const;
+};
+
+// Sends snapshots as JSON datagrams to a Unix domain socket.
+// Sends never block: snapshots are dropped while nobody is listening.
+class LiveMetricsPublisher {
+public:
+    explicit LiveMetricsPublisher(const std::string& socket_path);
+    ~LiveMetricsPublisher();
+
+    LiveMetricsPublisher(const LiveMetricsPublisher&) = delete;
+    LiveMetricsPublisher& operator=(const LiveMetricsPublisher&) = delete;
+
+    bool isOpen() const { return fd_ >= 0; }
+
+    // Returns true if the snapshot was delivered to a listener
+    bool publish(const MetricsSnapshot& snapshot);
+
+private:
+    std::string socket_path_;
+    int fd_;
+};
+
+// Samples a running simulation on its own thread and publishes a snapshot
+// every interval, plus a final one when stopped.
+class LiveMetricsMonitor {
+public:
+    LiveMetricsMonitor(const std::string& socket_path, int interval_ms,
+                       std::size_t jobs_total, float simulation_start,
+                       const JobQueue& ready_queue,
+                       std::mutex& queue_mutex,
+                       const JobQueue& completed_jobs,
+                       std::mutex& completed_mutex,
+                       const WorkerPoolBase& worker_pool);
+
+    ~LiveMetricsMonitor();
+
+    void start();
+
+    // Stop sampling and publish one last snapshot
+    void stop();
+
+private:
+    void monitorThread();
+
+    MetricsSnapshot takeSnapshot();
+
+    LiveMetricsPublisher publisher_;
+    std::chrono::milliseconds interval_;
+    std::size_t jobs_total_;
+    float simulation_start_;
+
+    const JobQueue& ready_queue_;
+    std::mutex& queue_mutex_;
+    const JobQueue& completed_jobs_;
+    std::mutex& completed_mutex_;
+    const WorkerPoolBase& worker_pool_;
+
+    // Latencies of completed jobs seen so far (only touched by the monitor)
+    std::size_t jobs_seen_;
+    std::vector<float> turnaround_times_;
+    std::vector<float> waiting_times_;
+
+    std::chrono::steady_clock::time_point started_at_;
+    std::thread thread_;
+    std::mutex stop_mutex_;
+    std::condition_variable stop_signal_;
+    bool stopping_;
+};
+
+}
+
+#endif
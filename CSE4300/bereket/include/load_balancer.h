@@ -0,0 +1,47 @@
+#ifndef CHRONOS_LOAD_BALANCER_H
+#define CHRONOS_LOAD_BALANCER_H
+
+#include "job.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace chronos {
+
+// Load of one machine as the dispatcher sees it
+struct MachineLoad {
+    std::uint32_t queue_length;     // jobs waiting or running
+    float work_left;                // CPU seconds still owed
+};
+
+// Cluster-level scheduling tier: picks the machine for each arriving job.
+//
+// Machine state is published once per epoch (see ClusterSimulator), so it is
+// up to one epoch stale. Balancers that look at load add their own routing
+// decisions since the last publication on top of it, which is exact except
+// for work completed during the epoch.
+class ILoadBalancer {
+public:
+    virtual ~ILoadBalancer() = default;
+
+    virtual std::string getName() const = 0;
+
+    // Start of an epoch: loads published by the shards, one per machine
+    virtual void beginEpoch(const std::vector<MachineLoad>& /*loads*/) {}
+
+    // Pick the machine (index into the load vector) for a job
+    virtual int route(const Job& job) = 0;
+};
+
+// Balancer names accepted by createLoadBalancer(), in comparison order
+std::vector<std::string> loadBalancerNames();
+
+// Create a balancer by name (case-insensitive); nullptr if unknown
+std::unique_ptr<ILoadBalancer> createLoadBalancer(const std::string& name, int num_machines,
+                                                  std::uint32_t seed);
+
+}
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef CHRONOS_MACHINE_MODEL_H
+#define CHRONOS_MACHINE_MODEL_H
+
+#include "job.h"
+#include "latency_histogram.h"
+#include "scheduling_policy.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace chronos {
+
+// Aggregates of the jobs a machine (or a whole shard) has completed.
+// Plain data so shards can hand it to the coordinator through shared memory.
+struct MachineStats {
+    std::uint64_t jobs_completed;
+    std::uint64_t context_switches;
+    double total_waiting_time;
+    double total_turnaround_time;
+    double busy_time;           // core-seconds spent executing
+    float last_finish;
+    LatencyHistogram turnaround;
+    LatencyHistogram waiting;
+
+    void clear();
+    void merge(const MachineStats& other);
+};
+
+// One machine of a simulated cluster: its cores and a per-core policy,
+// simulated as a discrete-event system in virtual time on the calling
+// thread. Unlike SchedulerEngine it needs no threads of its own, so a
+// single process can model many machines.
+class MachineModel {
+public:
+    MachineModel(int num_cores, std::unique_ptr<ISchedulingPolicy> policy);
+
+    // Hand a job to the machine. Jobs must be admitted in arrival order and
+    // not before the machine's clock.
+    void admit(const Job& job);
+
+    // Process every event before horizon, then move the clock to horizon
+    void advanceTo(float horizon);
+
+    // Run until all admitted work has completed
+    void drain();
+
+    float now() const { return now_; }
+
+    // Jobs admitted but not finished (waiting, ready or running)
+    std::size_t queueLength() const { return outstanding_jobs_; }
+
+    // CPU seconds still owed to admitted jobs
+    float workLeft() const;
+
+    const MachineStats& stats() const { return stats_; }
+
+private:
+    struct Core {
+        float free_at = 0.0f;
+        std::optional<Job> job;     // job whose slice ends at free_at
+    };
+
+    void completeSlices();
+    void releaseArrivals();
+    void dispatch();
+
+    std::unique_ptr<ISchedulingPolicy> policy_;
+    std::vector<Core> cores_;
+    std::deque<Job> inbox_;         // admitted, arrival still in the future
+    JobQueue ready_;
+    float now_;
+    double queued_work_;            // remaining time not covered by a running slice
+    std::size_t outstanding_jobs_;
+    MachineStats stats_;
+};
+
+}
+
+#endif
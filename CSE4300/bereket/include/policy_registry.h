@@ -0,0 +1,95 @@
+#ifndef CHRONOS_POLICY_REGISTRY_H
+#define CHRONOS_POLICY_REGISTRY_H
+
+#include "scheduling_policy.h"
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace chronos {
+
+// Parameters handed to every policy factory
+struct PolicyParams {
+    int quantum = 2;    // time slice for preemptive policies
+};
+
+using PolicyFactory = std::function<std::unique_ptr<ISchedulingPolicy>(const PolicyParams&)>;
+
+// Bumped whenever ISchedulingPolicy, Job or the registry change layout.
+// Plugins report the version they were built against and are rejected on mismatch.
+constexpr int CHRONOS_PLUGIN_ABI_VERSION = 6;
+
+// Maps policy names to factories. The built-in policies are registered on
+// first use; more can be added at run time from shared-object plugins.
+//
+// A plugin is a shared library exporting two C functions:
+//
+//   CHRONOS_PLUGIN_EXPORT int chronos_plugin_abi_version() {
+//       return chronos::CHRONOS_PLUGIN_ABI_VERSION;
+//   }
+//   CHRONOS_PLUGIN_EXPORT void chronos_register_policies(chronos::PolicyRegistry& registry) {
+//       registry.registerPolicy("MyPolicy", [](const chronos::PolicyParams&) {
+//           return std::make_unique<MyPolicy>();
+//       });
+//   }
+class PolicyRegistry {
+public:
+    static PolicyRegistry& instance();
+
+    virtual ~PolicyRegistry() = default;
+
+    // Register a policy under a name plus optional aliases (matched case-insensitively).
+    // Virtual so plugins reach it through the vtable and the executable
+    // doesn't have to export its symbols. Returns false if a name is taken.
+    virtual bool registerPolicy(const std::string& name, PolicyFactory factory,
+                                bool requires_quantum = false,
+                                const std::vector<std::string>& aliases = {});
+
+    // Create a policy by name or alias; nullptr if unknown
+    std::unique_ptr<ISchedulingPolicy> create(const std::string& name,
+                                              const PolicyParams& params) const;
+
+    // Canonical name for a name or alias, if registered
+    std::optional<std::string> canonicalName(const std::string& name) const;
+
+    bool requiresQuantum(const std::string& name) const;
+
+    // Canonical names in registration order (built-ins first)
+    std::vector<std::string> names() const;
+
+    // dlopen a plugin and let it register its policies. Prints an error and
+    // returns false if the library or its entry points can't be loaded.
+    bool loadPlugin(const std::string& path);
+
+private:
+    PolicyRegistry();
+
+    struct Entry {
+        std::string name;
+        PolicyFactory factory;
+        bool requires_quantum;
+    };
+
+    const Entry* find(const std::string& name) const;
+
+    std::vector<Entry> entries_;
+    std::map<std::string, std::size_t> lookup_;    // upper-cased name/alias -> entry
+
+    // Plugin handles stay open for the life of the process: policy vtables live in them
+    std::vector<void*> plugin_handles_;
+};
+
+}
+
+#if defined(_WIN32)
+#define CHRONOS_PLUGIN_EXPORT extern "C" __declspec(dllexport)
+#else
+#define CHRONOS_PLUGIN_EXPORT extern "C" __attribute__((visibility("default")))
+#endif
+
+#endif
@@ -13,7 +13,7 @@ class PriorityPolicy final : public ISchedulingPolicy {
 public:
     ~PriorityPolicy() override = default;
 
-    Job* getNextJob(std::vector<Job>& ready_queue) override;
+    Job* getNextJob(JobQueue& ready_queue) override;
 
     // Non-preemptive
     void onJobCompletion(Job* , float /*current_time*/) override {}
@@ -15,7 +15,7 @@ public:
     explicit RoundRobinPolicy(int quantum);
     ~RoundRobinPolicy() override = default;
 
-    Job* getNextJob(std::vector<Job>& ready_queue) override;
+    Job* getNextJob(JobQueue& ready_queue) override;
     void onJobCompletion(Job* completed_job, float current_time) override;
 
     std::string getName() const override { return "Round Robin"; }
@@ -23,11 +23,14 @@ public:
     float getTimeSlice() const override { return static_cast<float>(quantum_); }
     int getQuantum() const { return quantum_; }
 
+    std::vector<std::uint8_t> saveState() const override;
+    bool restoreState(const std::vector<std::uint8_t>& state) override;
+
 private:
     int quantum_;
     std::deque<int> rotation_;                 // job ids in rotation order
 
-    void syncRotationWithReadyQueue(const std::vector<Job>& ready_queue);
+    void syncRotationWithReadyQueue(const JobQueue& ready_queue);
     bool containsJob(int job_id) const;
 };
 
@@ -0,0 +1,49 @@
+#ifndef CHRONOS_RUN_ARENA_H
+#define CHRONOS_RUN_ARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+namespace chronos {
+
+// Monotonic arena that backs all per-run job storage (ready queue, completed
+// jobs, pending arrivals). Deallocation is a no-op and everything is released
+// in one shot when the arena is destroyed at the end of a run.
+//
+// The initial buffer is owned by the caller so it can be reused across runs;
+// when a run outgrows it the arena falls back to the heap and the caller can
+// grow the buffer to requiredCapacity() for the next run.
+class RunArena final : public std::pmr::memory_resource {
+public:
+    explicit RunArena(std::vector<std::byte>& buffer);
+
+    RunArena(const RunArena&) = delete;
+    RunArena& operator=(const RunArena&) = delete;
+
+    // Bytes handed out so far, including alignment padding
+    std::size_t bytesUsed() const;
+
+    // Buffer size that would have served this run without touching the heap
+    std::size_t requiredCapacity() const;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+    // Monotonic: memory is only reclaimed when the arena goes away
+    void do_deallocate(void* /*ptr*/, std::size_t /*bytes*/, std::size_t /*alignment*/) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    // The scheduler and worker threads allocate from the same arena
+    mutable std::mutex mutex_;
+    std::pmr::monotonic_buffer_resource resource_;
+    std::size_t bytes_used_;
+};
+
+}
+
+#endif
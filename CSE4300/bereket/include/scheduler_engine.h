@@ -7,14 +7,21 @@
 #include <atomic>
 #include <condition_variable>
 #include <cstddef>
+#include <deque>
+#include <memory_resource>
 #include <mutex>
+#include <optional>
+#include <string>
 #include <thread>
 #include <vector>
 
 namespace chronos {
 
-// Forward declaration
-class WorkerPool;
+// Forward declarations
+class DependencyTracker;
+class JobGraph;
+class WorkerPoolBase;
+struct SimulationSnapshot;
 
 struct ScheduleResult {
     std::vector<Job> completed_jobs;
@@ -26,6 +33,14 @@ struct ScheduleResult {
     int num_cores = 1;
     std::size_t dispatch_count = 0;
     std::size_t context_switches = 0;
+    bool interrupted = false;   // stopped early after writing a checkpoint
+
+    // Bounded-queue accounting (EngineConfig::queue_capacity)
+    std::size_t rejected_jobs = 0;  // turned away on arrival
+    std::size_t shed_jobs = 0;      // dropped from the ready queue after admission
+    float wasted_time = 0.0f;       // CPU time spent on jobs that were later shed
+
+    float critical_path = 0.0f;     // longest dependency chain (0 without a JobGraph)
 
     float averageWaitingTime() const {
         return completed_jobs.empty()
@@ -50,32 +65,142 @@ struct ScheduleResult {
     std::size_t contextSwitches() const {
         return context_switches;
     }
+
+    // Completed jobs per simulated second
+    float goodput() const {
+        return makespan > 0.0f ? static_cast<float>(completed_jobs.size()) / makespan : 0.0f;
+    }
+
+    // Fraction of offered jobs that were rejected or shed
+    float shedRate() const {
+        const std::size_t dropped = rejected_jobs + shed_jobs;
+        const std::size_t offered = completed_jobs.size() + dropped;
+        return offered == 0 ? 0.0f : static_cast<float>(dropped) / static_cast<float>(offered);
+    }
+};
+
+// What a full ready queue does with an arriving job
+enum class OverflowPolicy {
+    REJECT,         // turn the arriving job away
+    DROP_OLDEST,    // shed the longest-waiting queued job to make room
+    PRIORITY_SHED   // shed the lowest-priority job, which may be the arriving one
+};
+
+std::string overflowPolicyToString(OverflowPolicy policy);
+
+// Accepts reject, drop-oldest and priority-shed (case-insensitive)
+std::optional<OverflowPolicy> stringToOverflowPolicy(const std::string& name);
+
+// Engine settings that are independent of the scheduling policy
+struct EngineConfig {
+    // Wall-clock milliseconds slept per simulated second of CPU time.
+    // 0 runs in virtual time: cores never sleep and runs finish as fast as possible.
+    float time_scale_ms = 1000.0f;
+
+    // Print the job table and aggregate metrics when a run finishes
+    bool print_summary = true;
+
+    // Run built-in policies through a dispatch loop specialized for their
+    // concrete type (no virtual calls). Off = always use the virtual path.
+    bool specialize_policies = true;
+
+    // Unix datagram socket that receives live JSON snapshots (empty = disabled)
+    std::string metrics_socket;
+
+    // Wall-clock milliseconds between live snapshots
+    int metrics_interval_ms = 1000;
+
+    // Most jobs a core takes from the ready queue per lock hold; the policy
+    // picks the batch size up to this (ISchedulingPolicy::dispatchBatchSize).
+    // 1 = one job at a time.
+    std::size_t dispatch_batch = 1;
+
+    // Checkpoint file (empty = checkpointing disabled). Written every
+    // checkpoint_interval_ms of wall time (0 = never) and when a stop is requested.
+    std::string checkpoint_path;
+    int checkpoint_interval_ms = 0;
+
+    // Most jobs the ready queue holds (0 = unbounded); arrivals beyond it are
+    // handled by overflow_policy. Bounded runs step simulated time event by
+    // event and only let a core dispatch once simulated time reaches its
+    // clock, so the ready queue holds exactly the jobs waiting at that time
+    // (dispatch_batch is ignored).
+    std::size_t queue_capacity = 0;
+    OverflowPolicy overflow_policy = OverflowPolicy::REJECT;
 };
 
 class SchedulerEngine {
 public:
+    explicit SchedulerEngine(EngineConfig config = EngineConfig());
+
     // Run jobs using multithreaded worker pool
     ScheduleResult run(std::vector<Job> jobs, ISchedulingPolicy& policy, int num_cores);
 
+    // Run jobs with precedence constraints: a job is only admitted to the
+    // ready queue once all its predecessors in the graph have finished.
+    // Not supported together with checkpointing.
+    ScheduleResult run(std::vector<Job> jobs, ISchedulingPolicy& policy, int num_cores,
+                       const JobGraph& graph);
+
+    // Continue a run from a checkpoint file. The policy must be the one the
+    // checkpoint was taken with (same name and parameters); the core count
+    // comes from the checkpoint.
+    std::optional<ScheduleResult> resume(const std::string& checkpoint_path, ISchedulingPolicy& policy);
+
+    // Ask running simulations to checkpoint and stop. Async-signal-safe, so
+    // it can be called from a SIGTERM handler. No effect without checkpoint_path.
+    static void requestStop();
+
     // Print a summary table and aggregate metrics.
     void printSummary(const ScheduleResult& result, const ISchedulingPolicy& policy) const;
 
 private:
+    EngineConfig config_;
+
+    // Backing buffer for each run's arena, kept between runs so repeated
+    // runs (e.g. parameter sweeps) don't go back to malloc for job storage
+    std::vector<std::byte> arena_buffer_;
+
+    // Shared state of one simulation, handed to the scheduler thread
+    struct RunContext;
+
+    static std::atomic<bool> stop_requested_;
+
+    // Common tail of run() and resume(): arena setup, simulation, summary
+    ScheduleResult runFrom(SimulationSnapshot state, ISchedulingPolicy& policy,
+                           const JobGraph* graph);
+
+    // Pick the simulate() instantiation for the policy's concrete type,
+    // falling back to virtual dispatch for unknown policies
+    ScheduleResult dispatchSimulation(SimulationSnapshot state, ISchedulingPolicy& policy,
+                                      const JobGraph* graph, std::pmr::memory_resource& arena);
+
+    // Run the simulation from the given state with all per-run job storage
+    // taken from the arena
+    template <typename Policy>
+    ScheduleResult simulate(SimulationSnapshot state, Policy& policy, const JobGraph* graph,
+                            std::pmr::memory_resource& arena);
+
     void printJobTable(const std::vector<Job>& jobs) const;
     
     // Scheduler thread function - dispatches jobs to ready queue
-    void schedulerThread(std::vector<Job> jobs, ISchedulingPolicy& policy, 
-                       std::vector<Job>& ready_queue,
-                       std::mutex& queue_mutex,
-                       std::condition_variable& job_available,
-                       std::atomic<bool>& simulation_running,
-                       ScheduleResult& result,
-                       WorkerPool& worker_pool);
+    void schedulerThread(RunContext& ctx);
+
+    // Move arrivals up to current_time into the ready queue, applying the
+    // queue capacity. Returns how many were admitted. Caller holds the queue mutex.
+    std::size_t admitArrivals(RunContext& ctx, float current_time);
+
+    // Hand jobs unblocked by completions since the last call to pending.
+    // Caller holds the queue mutex.
+    void releaseDependents(RunContext& ctx);
+
+    // Quiesce the worker pool and write a checkpoint of the current state.
+    // The pool stays paused when stopping afterwards.
+    bool writeCheckpoint(RunContext& ctx, float current_time, bool stopping);
     
     // Collect completed jobs from ready queue
-    void collectCompletedJobs(std::vector<Job>& ready_queue, 
-                            std::vector<Job>& completed_jobs,
-                            std::mutex& queue_mutex);
+    void collectCompletedJobs(JobQueue& ready_queue, 
+                            std::vector<Job>& completed_jobs);
 };
 
 }
@@ -2,6 +2,9 @@
 #define CHRONOS_SCHEDULING_POLICY_H
 
 #include "job.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <memory>
 
@@ -15,7 +18,7 @@ public:
  
     // Returns: pointer to the selected job, or nullptr if no job is available
     // Note: The policy should not remove the job from the queue; that's the scheduler's responsibility
-    virtual Job* getNextJob(std::vector<Job>& ready_queue) = 0;
+    virtual Job* getNextJob(JobQueue& ready_queue) = 0;
     
 
     // current_time: current simulation time
@@ -31,6 +34,24 @@ public:
 
     // Optional time slice (seconds). Negative ⇒ run job to completion.
     virtual float getTimeSlice() const { return -1.0f; }
+
+    // How many jobs (1..max_batch) a core takes in one go when the engine
+    // dispatches in batches; getNextJob() picks them. The default is the
+    // core's fair share of the ready queue, so batching never leaves other
+    // cores idle while one core holds a backlog.
+    virtual std::size_t dispatchBatchSize(std::size_t ready_jobs, int num_cores,
+                                          std::size_t max_batch) const {
+        const std::size_t cores = num_cores > 0 ? static_cast<std::size_t>(num_cores) : 1;
+        const std::size_t share = (ready_jobs + cores - 1) / cores;
+        return std::max<std::size_t>(1, std::min(share, max_batch));
+    }
+
+    // Internal state for checkpoints (see checkpoint.h). Stateless policies
+    // keep the defaults; called with the ready queue locked.
+    virtual std::vector<std::uint8_t> saveState() const { return {}; }
+
+    // Restore state from saveState(); false if it doesn't belong to this policy
+    virtual bool restoreState(const std::vector<std::uint8_t>& state) { return state.empty(); }
 };
 
 }
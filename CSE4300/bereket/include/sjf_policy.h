@@ -13,7 +13,7 @@ public:
     ~SJFPolicy() override = default;
 
     // Pick job with the smallest burst time -->  tie-break by arrival, then job id.
-    Job* getNextJob(std::vector<Job>& ready_queue) override;
+    Job* getNextJob(JobQueue& ready_queue) override;
 
     // SJF is non-preemptive
     void onJobCompletion(Job* /*completed_job*/, float /*current_time*/) override {}
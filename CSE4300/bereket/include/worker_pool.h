@@ -5,6 +5,7 @@
 #include "scheduling_policy.h"
 
 #include <atomic>
+#include <cstddef>
 #include <condition_variable>
 #include <mutex>
 #include <thread>
@@ -12,23 +13,10 @@
 
 namespace chronos {
 
-// Manages worker threads that simulate CPU cores executing jobs
-class WorkerPool {
+// State shared by every WorkerPool instantiation. The scheduler thread and
+// live metrics only need this part, so they don't depend on the policy type.
+class WorkerPoolBase {
 public:
-    WorkerPool(int num_cores, ISchedulingPolicy& policy, 
-               std::vector<Job>& ready_queue,
-               std::mutex& queue_mutex,
-               std::condition_variable& job_available,
-               std::atomic<bool>& simulation_running,
-               std::vector<Job>& completed_jobs,
-               std::mutex& completed_mutex,
-               std::atomic<size_t>& context_switches);
-    
-    ~WorkerPool();
-    
-    // Start all worker threads
-    void start();
-    
     // Stop all worker threads (wait for completion)
     void stop();
     
@@ -38,28 +26,103 @@ public:
     // Check if all workers are idle
     bool allIdle() const;
 
-private:
-    // Worker thread function - simulates CPU core execution
-    void workerThread(int core_id);
-    
+    // Simulated time at which a core becomes free
+    float coreClock(int core_id) const { return core_clock_[core_id].load(); }
+
+    // Total simulated time a core has spent executing jobs
+    float coreBusyTime(int core_id) const { return core_busy_time_[core_id].load(); }
+
+    // Seed per-core clocks from a checkpoint; call before start()
+    void restoreCoreTimes(const std::vector<float>& clock, const std::vector<float>& busy_time);
+
+    // Stop handing out new slices; running slices still finish. Once allIdle()
+    // the pool is quiescent and can be checkpointed. While paused, clearing
+    // simulation_running makes workers exit without draining the ready queue.
+    void pauseDispatch();
+    void resumeDispatch();
+
+    // Only let cores whose clock has reached `time` take jobs, so work waits
+    // in the ready queue until simulated time catches up with it. Defaults
+    // to no limit. Caller holds the queue mutex and notifies job_available.
+    void setDispatchHorizon(float time) { dispatch_horizon_ = time; }
+
+    // Earliest simulated time at which any core is free
+    float earliestCoreClock() const;
+
+protected:
+    WorkerPoolBase(int num_cores,
+                   JobQueue& ready_queue,
+                   std::mutex& queue_mutex,
+                   std::condition_variable& job_available,
+                   std::condition_variable& scheduler_wake,
+                   std::atomic<bool>& simulation_running,
+                   JobQueue& completed_jobs,
+                   std::mutex& completed_mutex,
+                   std::atomic<size_t>& context_switches,
+                   float time_scale_ms,
+                   std::size_t dispatch_batch);
+
+    ~WorkerPoolBase();
+
     // Execute a job on a CPU core (simulated by sleeping)
     void executeJob(Job& job, float time_slice, int core_id);
     
     int num_cores_;
-    ISchedulingPolicy& policy_;
-    std::vector<Job>& ready_queue_;
+    JobQueue& ready_queue_;
     std::mutex& queue_mutex_;
     std::condition_variable& job_available_;
+    std::condition_variable& scheduler_wake_;   // notified when the queue drains or the pool goes idle
     std::atomic<bool>& simulation_running_;
-    std::vector<Job>& completed_jobs_;
+    JobQueue& completed_jobs_;
     std::mutex& completed_mutex_;
     std::atomic<size_t>& context_switches_;
+    float time_scale_ms_;   // wall ms slept per simulated second (0 = no sleep)
+    std::size_t dispatch_batch_;    // most jobs a core takes per lock hold
     
     std::vector<std::thread> workers_;
     std::atomic<int> active_workers_;
+    bool paused_;           // guarded by queue_mutex_
+    float dispatch_horizon_;    // guarded by queue_mutex_
     
     // Track which core is executing which job
     std::vector<std::atomic<Job*>> executing_jobs_;
+
+    // Per-core clocks, written only by the owning worker (read by monitors)
+    std::vector<std::atomic<float>> core_clock_;
+    std::vector<std::atomic<float>> core_busy_time_;
+};
+
+// Manages worker threads that simulate CPU cores executing jobs.
+//
+// Policy is either a concrete (final) policy class, in which case the dispatch
+// loop calls it directly and the compiler can inline it, or ISchedulingPolicy
+// for policies only known at run time. Instantiations are explicit and live
+// in worker_pool.cpp.
+template <typename Policy>
+class WorkerPool : public WorkerPoolBase {
+public:
+    WorkerPool(int num_cores, Policy& policy, 
+               JobQueue& ready_queue,
+               std::mutex& queue_mutex,
+               std::condition_variable& job_available,
+               std::condition_variable& scheduler_wake,
+               std::atomic<bool>& simulation_running,
+               JobQueue& completed_jobs,
+               std::mutex& completed_mutex,
+               std::atomic<size_t>& context_switches,
+               float time_scale_ms = 1000.0f,
+               std::size_t dispatch_batch = 1);
+    
+    ~WorkerPool();
+    
+    // Start all worker threads
+    void start();
+
+private:
+    // Worker thread function - simulates CPU core execution
+    void workerThread(int core_id);
+    
+    Policy& policy_;
 };
 
 }
@@ -2,14 +2,16 @@
 #include "job.h"
 #include "scheduler_engine.h"
 #include "algorithm_comparator.h"
+#include "batch_simulator.h"
+#include "cluster_simulator.h"
 #include "file_writer.h"
+#include "job_graph.h"
 #include "metrics_collector.h"
-#include "fcfs_policy.h"
-#include "sjf_policy.h"
-#include "priority_policy.h"
-#include "rr_policy.h"
+#include "policy_registry.h"
 #include "scheduling_policy.h"
 
+#include <algorithm>
+#include <csignal>
 #include <iostream>
 #include <memory>
 #include <random>
@@ -38,25 +40,39 @@ std::vector<Job> generateSampleJobs(int num_jobs) {
     return jobs;
 }
 
+// Generate a pipeline-like DAG over the sample jobs: everything is submitted
+// at time 0 and each job depends on up to three of the ten jobs before it
+JobGraph generateSampleGraph(std::vector<Job>& jobs) {
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<int> fan_in_dist(0, 3);
+
+    JobGraph graph;
+    for (auto& job : jobs) {
+        job = Job(job.getId(), 0.0f, job.getBurstTime(), job.getPriority());
+        const int id = job.getId();
+        if (id == 1) {
+            continue;
+        }
+        std::uniform_int_distribution<int> pred_dist(std::max(1, id - 10), id - 1);
+        const int fan_in = fan_in_dist(gen);
+        for (int k = 0; k < fan_in; ++k) {
+            graph.addDependency(id, pred_dist(gen));
+        }
+    }
+    return graph;
+}
+
 // Create policy from CLI options
 std::unique_ptr<ISchedulingPolicy> createPolicy(const CLIOptions& options) {
-    switch (options.algorithm) {
-        case SchedulingAlgorithm::FCFS:
-            return std::make_unique<FCFSPolicy>();
-        case SchedulingAlgorithm::SJF:
-            return std::make_unique<SJFPolicy>();
-        case SchedulingAlgorithm::PRIORITY:
-            return std::make_unique<PriorityPolicy>();
-        case SchedulingAlgorithm::RR:
-            if (options.quantum.has_value()) {
-                return std::make_unique<RoundRobinPolicy>(options.quantum.value());
-            } else {
-                std::cerr << "Error: Quantum required for Round Robin algorithm\n";
-                return nullptr;
-            }
-        default:
-            return nullptr;
-    }
+    PolicyParams params;
+    params.quantum = options.quantum.value_or(params.quantum);
+    return PolicyRegistry::instance().create(options.algorithm, params);
+}
+
+// SIGTERM/SIGINT: checkpoint and stop instead of losing the run
+extern "C" void onTerminateSignal(int /*signal*/) {
+    SchedulerEngine::requestStop();
 }
 
 } // namespace chronos
@@ -70,18 +86,79 @@ int main(int argc, char* argv[]) {
         return 1;
     }
     
-    // Generate jobs
-    if (options.num_jobs <= 0) {
+    if (options.cluster_machines > 0) {
+        ClusterConfig cluster_config;
+        cluster_config.num_machines = options.cluster_machines;
+        cluster_config.cores_per_machine = options.num_cores;
+        cluster_config.num_shards = options.cluster_shards;
+        cluster_config.num_jobs = static_cast<std::size_t>(options.num_jobs);
+        cluster_config.load = options.cluster_load;
+        cluster_config.epoch = options.cluster_epoch;
+        cluster_config.balancer = options.balancer;
+        cluster_config.policy_factory = [&options]() { return createPolicy(options); };
+
+        if (options.compare_balancers) {
+            return ClusterSimulator::compareBalancers(cluster_config) ? 0 : 1;
+        }
+
+        ClusterSimulator cluster(cluster_config);
+        const ClusterResult cluster_result = cluster.run();
+        if (!cluster_result.ok) {
+            return 1;
+        }
+        ClusterSimulator::printSummary(cluster_result, cluster_config);
+        return 0;
+    }
+
+    if (!options.batch_policy.empty()) {
+        BatchConfig batch_config;
+        batch_config.num_cores = options.num_cores;
+        batch_config.num_jobs = static_cast<std::size_t>(options.num_jobs);
+        batch_config.load = options.cluster_load;
+        batch_config.policy = options.batch_policy;
+        batch_config.estimate_factor = options.estimate_factor;
+
+        if (options.compare_all) {
+            return BatchSimulator::comparePolicies(batch_config) ? 0 : 1;
+        }
+
+        const BatchResult batch_result = BatchSimulator(batch_config).run();
+        if (!batch_result.ok) {
+            return 1;
+        }
+        BatchSimulator::printSummary(batch_result, batch_config);
+        return 0;
+    }
+
+    // Generate jobs (a resumed run brings its own)
+    if (options.num_jobs <= 0 && options.resume_path.empty()) {
         std::cerr << "Error: Number of jobs must be positive\n";
         return 1;
     }
     
     std::vector<Job> jobs = generateSampleJobs(options.num_jobs);
+    const JobGraph graph = options.dag ? generateSampleGraph(jobs) : JobGraph();
+
+    EngineConfig engine_config;
+    engine_config.time_scale_ms = options.time_scale_ms;
+    engine_config.metrics_socket = options.metrics_socket;
+    engine_config.metrics_interval_ms = options.metrics_interval_ms;
+    engine_config.dispatch_batch = static_cast<std::size_t>(options.dispatch_batch);
+    engine_config.checkpoint_path = options.checkpoint_path;
+    engine_config.checkpoint_interval_ms = options.checkpoint_interval_ms;
+    engine_config.queue_capacity = static_cast<std::size_t>(options.queue_capacity);
+    engine_config.overflow_policy =
+        stringToOverflowPolicy(options.overflow_policy).value_or(OverflowPolicy::REJECT);
+
+    if (!options.checkpoint_path.empty()) {
+        std::signal(SIGTERM, onTerminateSignal);
+        std::signal(SIGINT, onTerminateSignal);
+    }
     
     if (options.compare_all) {
         int quantum = options.quantum.value_or(2);
         bool success = AlgorithmComparator::compareAll(
-            jobs, options.num_cores, quantum);
+            jobs, options.num_cores, quantum, engine_config, graph);
         return success ? 0 : 1;
     }
     
@@ -92,14 +169,29 @@ int main(int argc, char* argv[]) {
     }
     
     // Run scheduler
-    SchedulerEngine engine;
-    auto result = engine.run(std::move(jobs), *policy, options.num_cores);
+    SchedulerEngine engine(engine_config);
+    ScheduleResult result;
+    if (!options.resume_path.empty()) {
+        auto resumed = engine.resume(options.resume_path, *policy);
+        if (!resumed) {
+            return 1;
+        }
+        result = std::move(*resumed);
+    } else {
+        result = engine.run(std::move(jobs), *policy, options.num_cores, graph);
+    }
+
+    if (result.interrupted) {
+        std::cout << "Run interrupted; checkpoint written to " << options.checkpoint_path
+                  << ". Continue with --resume " << options.checkpoint_path << "\n";
+        return 1;
+    }
     
     MetricsCollector collector;
     collector.setMakespan(result.makespan);
     collector.setCpuActiveTime(result.cpu_active_time);
     collector.setContextSwitches(result.context_switches);
-    collector.setNumCores(options.num_cores);
+    collector.setNumCores(result.num_cores);
     for (const auto& job : result.completed_jobs) {
         collector.recordJobCompletion(job);
     }
@@ -0,0 +1,90 @@
+// Example chronos plugin: lottery scheduling.
+//
+// Every ready job holds as many tickets as its priority and each dispatch
+// draws one ticket at random, so higher-priority jobs run more often without
+// starving the rest. Build as a shared library against ../include and load
+// it with `schedsim --plugin <path> --algo Lottery`.
+
+#include "policy_registry.h"
+#include "scheduling_policy.h"
+
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+
+namespace {
+
+class LotteryPolicy final : public chronos::ISchedulingPolicy {
+public:
+    explicit LotteryPolicy(int quantum)
+        : quantum_(quantum)
+        , gen_(4300) {}
+
+    chronos::Job* getNextJob(chronos::JobQueue& ready_queue) override {
+        long total_tickets = 0;
+        for (const auto& job : ready_queue) {
+            total_tickets += tickets(job);
+        }
+        if (total_tickets == 0) {
+            return nullptr;
+        }
+
+        std::uniform_int_distribution<long> draw(0, total_tickets - 1);
+        long winner = draw(gen_);
+        for (auto& job : ready_queue) {
+            winner -= tickets(job);
+            if (winner < 0) {
+                return &job;
+            }
+        }
+        return nullptr;
+    }
+
+    void onJobCompletion(chronos::Job* /*completed_job*/, float /*current_time*/) override {}
+
+    std::string getName() const override { return "Lottery"; }
+
+    bool isPreemptive() const override { return true; }
+
+    float getTimeSlice() const override { return static_cast<float>(quantum_); }
+
+    // The generator state is all a checkpoint needs to replay the same draws
+    std::vector<std::uint8_t> saveState() const override {
+        std::ostringstream os;
+        os << quantum_ << ' ' << gen_;
+        const std::string text = os.str();
+        return std::vector<std::uint8_t>(text.begin(), text.end());
+    }
+
+    bool restoreState(const std::vector<std::uint8_t>& state) override {
+        std::istringstream is(std::string(state.begin(), state.end()));
+        int quantum = 0;
+        std::mt19937 gen;
+        if (!(is >> quantum >> gen) || quantum != quantum_) {
+            return false;
+        }
+        gen_ = gen;
+        return true;
+    }
+
+private:
+    static long tickets(const chronos::Job& job) {
+        return job.getPriority() > 0 ? job.getPriority() : 1;
+    }
+
+    int quantum_;
+    std::mt19937 gen_;
+};
+
+} // namespace
+
+CHRONOS_PLUGIN_EXPORT int chronos_plugin_abi_version() {
+    return chronos::CHRONOS_PLUGIN_ABI_VERSION;
+}
+
+CHRONOS_PLUGIN_EXPORT void chronos_register_policies(chronos::PolicyRegistry& registry) {
+    registry.registerPolicy("Lottery", [](const chronos::PolicyParams& params) {
+        return std::make_unique<LotteryPolicy>(params.quantum);
+    }, true);
+}
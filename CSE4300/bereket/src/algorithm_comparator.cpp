@@ -1,9 +1,6 @@
 #include "algorithm_comparator.h"
 
-#include "fcfs_policy.h"
-#include "sjf_policy.h"
-#include "priority_policy.h"
-#include "rr_policy.h"
+#include "policy_registry.h"
 #include "scheduler_engine.h"
 #include "file_writer.h"
 
@@ -15,26 +12,12 @@
 
 namespace chronos {
 
-std::unique_ptr<ISchedulingPolicy> AlgorithmComparator::createPolicy(
-    SchedulingAlgorithm algo, int quantum) {
-    switch (algo) {
-        case SchedulingAlgorithm::FCFS:
-            return std::make_unique<FCFSPolicy>();
-        case SchedulingAlgorithm::SJF:
-            return std::make_unique<SJFPolicy>();
-        case SchedulingAlgorithm::PRIORITY:
-            return std::make_unique<PriorityPolicy>();
-        case SchedulingAlgorithm::RR:
-            return std::make_unique<RoundRobinPolicy>(quantum);
-        default:
-            return nullptr;
-    }
-}
-
 bool AlgorithmComparator::runAndWriteAlgorithm(
     std::vector<Job> jobs,
     std::unique_ptr<ISchedulingPolicy> policy,
     int num_cores,
+    const EngineConfig& config,
+    const JobGraph& graph,
     const std::string& output_dir) {
     
     if (!policy) {
@@ -52,8 +35,8 @@ bool AlgorithmComparator::runAndWriteAlgorithm(
     }
     
     // Run scheduler
-    SchedulerEngine engine;
-    auto schedule_result = engine.run(std::move(jobs_copy), *policy, num_cores);
+    SchedulerEngine engine(config);
+    auto schedule_result = engine.run(std::move(jobs_copy), *policy, num_cores, graph);
     
     // Create metrics collector from schedule result
     MetricsCollector collector;
@@ -70,7 +53,8 @@ bool AlgorithmComparator::runAndWriteAlgorithm(
     return FileWriter::writeSummaryCSV(collector, *policy, output_dir + "/summary.csv");
 }
 
-bool AlgorithmComparator::compareAll(std::vector<Job> jobs, int num_cores, int quantum) {
+bool AlgorithmComparator::compareAll(std::vector<Job> jobs, int num_cores, int quantum,
+                                     const EngineConfig& config, const JobGraph& graph) {
     if (jobs.empty()) {
         std::cerr << "Error: No jobs provided for comparison\n";
         return false;
@@ -80,13 +64,10 @@ bool AlgorithmComparator::compareAll(std::vector<Job> jobs, int num_cores, int q
     std::cout << "Running All Algorithms for Comparison\n";
     std::cout << "========================================\n\n";
     
-    // List of algorithms to run
-    const std::vector<SchedulingAlgorithm> algorithms = {
-        SchedulingAlgorithm::FCFS,
-        SchedulingAlgorithm::SJF,
-        SchedulingAlgorithm::PRIORITY,
-        SchedulingAlgorithm::RR
-    };
+    // Every registered policy, including any loaded from plugins
+    const PolicyRegistry& registry = PolicyRegistry::instance();
+    PolicyParams params;
+    params.quantum = quantum;
     
     // Clear summary.csv for fresh comparison
     std::ofstream clear_file("output/summary.csv", std::ios::trunc);
@@ -95,19 +76,20 @@ bool AlgorithmComparator::compareAll(std::vector<Job> jobs, int num_cores, int q
     bool all_success = true;
     
     // Run each algorithm
-    for (auto algo : algorithms) {
-        auto policy = createPolicy(algo, quantum);
+    for (const auto& algo : registry.names()) {
+        auto policy = registry.create(algo, params);
         if (!policy) {
             std::cerr << "Error: Failed to create policy for " 
-                      << CLIParser::algorithmToString(algo) << "\n";
+                      << algo << "\n";
             all_success = false;
             continue;
         }
         
-        std::cout << "Running " << policy->getName() << "...\n";
-        bool success = runAndWriteAlgorithm(jobs, std::move(policy), num_cores);
+        const std::string name = policy->getName();
+        std::cout << "Running " << name << "...\n";
+        bool success = runAndWriteAlgorithm(jobs, std::move(policy), num_cores, config, graph);
         if (!success) {
-            std::cerr << "Warning: Failed to run " << policy->getName() << "\n";
+            std::cerr << "Warning: Failed to run " << name << "\n";
             all_success = false;
         }
     }
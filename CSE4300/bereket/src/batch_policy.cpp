@@ -0,0 +1,228 @@
+#include "batch_policy.h"
+#include "batch_simulator.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <iterator>
+#include <utility>
+
+namespace chronos {
+namespace {
+
+// When a running job is expected to release its cores. A job that has
+// outlived its estimate is assumed to be about to finish.
+float plannedEnd(const BatchAllocation& allocation, float factor, float now) {
+    const Job& job = allocation.job;
+    return std::max(now, job.getStartTime() + factor * job.getRuntimeEstimate());
+}
+
+// Free cores over time as a step function: steps[i].second cores are free
+// from steps[i].first until the next step. The last step runs forever.
+class CoreProfile {
+public:
+    CoreProfile(const BatchSimulator& sim, float factor) {
+        std::vector<std::pair<float, int>> releases;
+        releases.reserve(sim.running().size());
+        for (const auto& allocation : sim.running()) {
+            // Pending threads hold no cores yet; gang jobs never have any
+            releases.emplace_back(plannedEnd(allocation, factor, sim.now()), allocation.cores);
+        }
+        std::sort(releases.begin(), releases.end());
+
+        int free = sim.freeCores();
+        steps_.emplace_back(sim.now(), free);
+        for (const auto& release : releases) {
+            free += release.second;
+            if (release.first == steps_.back().first) {
+                steps_.back().second = free;
+            } else {
+                steps_.emplace_back(release.first, free);
+            }
+        }
+    }
+
+    // Earliest time at which `cores` stay free for `duration`
+    float earliestStart(int cores, float duration) const {
+        for (std::size_t i = 0; i < steps_.size(); ++i) {
+            const float end = steps_[i].first + duration;
+            bool fits = true;
+            for (std::size_t j = i; j < steps_.size() && (j == i || steps_[j].first < end); ++j) {
+                if (steps_[j].second < cores) {
+                    fits = false;
+                    break;
+                }
+            }
+            if (fits) {
+                return steps_[i].first;
+            }
+        }
+        return steps_.back().first;
+    }
+
+    // Take `cores` out of [start, start + duration)
+    void reserve(float start, float duration, int cores) {
+        const std::size_t first = split(start);
+        const std::size_t last = split(start + duration);
+        for (std::size_t i = first; i < last; ++i) {
+            steps_[i].second -= cores;
+        }
+    }
+
+private:
+    // Index of the step starting exactly at `time`, inserting one if needed
+    std::size_t split(float time) {
+        auto it = std::lower_bound(steps_.begin(), steps_.end(), time,
+                                   [](const std::pair<float, int>& step, float t) {
+                                       return step.first < t;
+                                   });
+        if (it != steps_.end() && it->first == time) {
+            return static_cast<std::size_t>(it - steps_.begin());
+        }
+        // Steps start at "now", so there is always one before `time`
+        const int free = std::prev(it)->second;
+        it = steps_.insert(it, {time, free});
+        return static_cast<std::size_t>(it - steps_.begin());
+    }
+
+    std::vector<std::pair<float, int>> steps_;
+};
+
+} // namespace
+
+void GangPolicy::schedule(BatchSimulator& sim) {
+    while (!sim.waiting().empty() && sim.waiting().front().getNumThreads() <= sim.freeCores()) {
+        sim.start(0, sim.waiting().front().getNumThreads());
+    }
+}
+
+RelaxedCoschedulingPolicy::RelaxedCoschedulingPolicy(float min_fraction)
+    : min_fraction_(std::clamp(min_fraction, 0.0f, 1.0f)) {}
+
+void RelaxedCoschedulingPolicy::schedule(BatchSimulator& sim) {
+    // The simulator hands freed cores to pending threads before asking us,
+    // so at most one job is ever partially started
+    while (!sim.waiting().empty() && sim.freeCores() > 0) {
+        const int threads = sim.waiting().front().getNumThreads();
+        const int needed = std::max(1, static_cast<int>(std::ceil(min_fraction_ * threads)));
+        if (sim.freeCores() < needed) {
+            break;
+        }
+        sim.start(0, std::min(threads, sim.freeCores()));
+    }
+}
+
+void FirstFitBackfillPolicy::schedule(BatchSimulator& sim) {
+    std::size_t i = 0;
+    while (i < sim.waiting().size() && sim.freeCores() > 0) {
+        const int threads = sim.waiting()[i].getNumThreads();
+        if (threads <= sim.freeCores()) {
+            sim.start(i, threads);  // the next job slides into slot i
+        } else {
+            ++i;
+        }
+    }
+}
+
+EasyBackfillPolicy::EasyBackfillPolicy(float estimate_factor)
+    : estimate_factor_(estimate_factor) {}
+
+void EasyBackfillPolicy::schedule(BatchSimulator& sim) {
+    // Plain FCFS while the head job fits
+    while (!sim.waiting().empty() && sim.waiting().front().getNumThreads() <= sim.freeCores()) {
+        sim.start(0, sim.waiting().front().getNumThreads());
+    }
+    if (sim.waiting().size() < 2 || sim.freeCores() == 0) {
+        return;
+    }
+
+    // Shadow time: when enough running jobs should have finished for the
+    // head; `extra` is what the head will leave free at that point
+    std::vector<std::pair<float, int>> releases;
+    releases.reserve(sim.running().size());
+    for (const auto& allocation : sim.running()) {
+        releases.emplace_back(plannedEnd(allocation, estimate_factor_, sim.now()), allocation.cores);
+    }
+    std::sort(releases.begin(), releases.end());
+
+    const int head_threads = sim.waiting().front().getNumThreads();
+    int available = sim.freeCores();
+    float shadow = sim.now();
+    for (const auto& release : releases) {
+        if (available >= head_threads) {
+            break;
+        }
+        available += release.second;
+        shadow = release.first;
+    }
+    int extra = available - head_threads;
+
+    std::size_t i = 1;
+    while (i < sim.waiting().size() && sim.freeCores() > 0) {
+        const Job& job = sim.waiting()[i];
+        const int threads = job.getNumThreads();
+        const bool done_by_shadow =
+            sim.now() + estimate_factor_ * job.getRuntimeEstimate() <= shadow;
+        if (threads <= sim.freeCores() && (done_by_shadow || threads <= extra)) {
+            if (!done_by_shadow) {
+                extra -= threads;
+            }
+            sim.start(i, threads);
+        } else {
+            ++i;
+        }
+    }
+}
+
+ConservativeBackfillPolicy::ConservativeBackfillPolicy(float estimate_factor)
+    : estimate_factor_(estimate_factor) {}
+
+void ConservativeBackfillPolicy::schedule(BatchSimulator& sim) {
+    if (sim.waiting().empty() || sim.freeCores() == 0) {
+        return;
+    }
+
+    // Once the cores are gone nobody else can start now, and reservations
+    // further back in the queue cannot change that
+    CoreProfile profile(sim, estimate_factor_);
+    std::size_t i = 0;
+    while (i < sim.waiting().size() && sim.freeCores() > 0) {
+        const Job& job = sim.waiting()[i];
+        const int threads = job.getNumThreads();
+        const float duration = estimate_factor_ * job.getRuntimeEstimate();
+        const float start = profile.earliestStart(threads, duration);
+        profile.reserve(start, duration, threads);
+        if (start <= sim.now() && sim.start(i, threads)) {
+            continue;   // the next job slides into slot i
+        }
+        ++i;
+    }
+}
+
+std::vector<std::string> batchPolicyNames() {
+    return {"gang", "relaxed", "backfill", "easy", "conservative"};
+}
+
+std::unique_ptr<IBatchPolicy> createBatchPolicy(const std::string& name, float estimate_factor) {
+    std::string key = name;
+    std::transform(key.begin(), key.end(), key.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (key == "gang") {
+        return std::make_unique<GangPolicy>();
+    }
+    if (key == "relaxed") {
+        return std::make_unique<RelaxedCoschedulingPolicy>();
+    }
+    if (key == "backfill") {
+        return std::make_unique<FirstFitBackfillPolicy>();
+    }
+    if (key == "easy") {
+        return std::make_unique<EasyBackfillPolicy>(estimate_factor);
+    }
+    if (key == "conservative") {
+        return std::make_unique<ConservativeBackfillPolicy>(estimate_factor);
+    }
+    return nullptr;
+}
+
+}
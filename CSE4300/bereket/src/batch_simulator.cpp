@@ -0,0 +1,303 @@
+#include "batch_simulator.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+
+namespace chronos {
+
+float BatchResult::averageWaitingTime() const {
+    if (completed_jobs.empty()) {
+        return 0.0f;
+    }
+    double total = 0.0;
+    for (const auto& job : completed_jobs) {
+        total += job.getWaitingTime();
+    }
+    return static_cast<float>(total / static_cast<double>(completed_jobs.size()));
+}
+
+float BatchResult::averageTurnaroundTime() const {
+    if (completed_jobs.empty()) {
+        return 0.0f;
+    }
+    double total = 0.0;
+    for (const auto& job : completed_jobs) {
+        total += job.getTurnaroundTime();
+    }
+    return static_cast<float>(total / static_cast<double>(completed_jobs.size()));
+}
+
+float BatchResult::maxWaitingTime() const {
+    float longest = 0.0f;
+    for (const auto& job : completed_jobs) {
+        longest = std::max(longest, job.getWaitingTime());
+    }
+    return longest;
+}
+
+float BatchResult::utilization() const {
+    const double capacity = static_cast<double>(makespan) * num_cores;
+    return capacity > 0.0 ? static_cast<float>(std::min(1.0, busy_time / capacity)) : 0.0f;
+}
+
+float BatchResult::averageBoundedSlowdown(float bound) const {
+    if (completed_jobs.empty()) {
+        return 0.0f;
+    }
+    double total = 0.0;
+    for (const auto& job : completed_jobs) {
+        const double runtime = std::max(job.getBurstTime(), bound);
+        total += runtime > 0.0 ? std::max(1.0, job.getTurnaroundTime() / runtime) : 1.0;
+    }
+    return static_cast<float>(total / static_cast<double>(completed_jobs.size()));
+}
+
+BatchSimulator::BatchSimulator(BatchConfig config)
+    : config_(std::move(config)) {}
+
+std::vector<Job> BatchSimulator::generateWorkload(const BatchConfig& config) {
+    std::vector<Job> jobs;
+    if (config.num_cores <= 0 || config.load <= 0.0f) {
+        return jobs;
+    }
+
+    // Thread counts 1, 2, 4, ... up to the machine width, equally likely
+    int max_shift = 0;
+    while ((2 << max_shift) <= config.num_cores) {
+        ++max_shift;
+    }
+    const double mean_threads = static_cast<double>((2 << max_shift) - 1) / (max_shift + 1);
+    const double mean_burst = 5.5;
+
+    std::mt19937 gen(config.seed);
+    std::exponential_distribution<double> interarrival(
+        config.load * config.num_cores / (mean_threads * mean_burst));
+    std::uniform_int_distribution<int> shift_dist(0, max_shift);
+    std::uniform_real_distribution<float> burst_dist(1.0f, 10.0f);
+    std::uniform_int_distribution<int> priority_dist(1, 5);
+    std::uniform_real_distribution<float> overestimate_dist(
+        1.0f, std::max(1.0f, config.max_overestimate));
+
+    jobs.reserve(config.num_jobs);
+    double clock = 0.0;
+    for (std::size_t i = 1; i <= config.num_jobs; ++i) {
+        clock += interarrival(gen);
+        Job job(static_cast<int>(i), static_cast<float>(clock), burst_dist(gen), priority_dist(gen));
+        job.setNumThreads(1 << shift_dist(gen));
+        job.setRuntimeEstimate(job.getBurstTime() * overestimate_dist(gen));
+        jobs.push_back(job);
+    }
+    return jobs;
+}
+
+BatchResult BatchSimulator::run() {
+    auto policy = createBatchPolicy(config_.policy, config_.estimate_factor);
+    if (!policy) {
+        std::cerr << "Error: Unknown batch policy '" << config_.policy << "'. Must be one of";
+        for (const auto& name : batchPolicyNames()) {
+            std::cerr << " " << name;
+        }
+        std::cerr << "\n";
+        return BatchResult{};
+    }
+    return run(generateWorkload(config_), *policy);
+}
+
+BatchResult BatchSimulator::run(std::vector<Job> jobs, IBatchPolicy& policy) {
+    BatchResult result;
+    result.policy = policy.getName();
+    result.num_cores = config_.num_cores;
+    if (config_.num_cores <= 0) {
+        std::cerr << "Error: Batch machine needs at least one core\n";
+        return result;
+    }
+
+    std::stable_sort(jobs.begin(), jobs.end(), [](const Job& a, const Job& b) {
+        return a.getArrivalTime() < b.getArrivalTime();
+    });
+
+    now_ = 0.0f;
+    free_cores_ = config_.num_cores;
+    waiting_.clear();
+    running_.clear();
+    events_ = {};
+    result.completed_jobs.reserve(jobs.size());
+
+    std::size_t next = 0;
+    while (next < jobs.size() || !waiting_.empty() || !running_.empty()) {
+        float event_time = std::numeric_limits<float>::infinity();
+        if (next < jobs.size()) {
+            event_time = jobs[next].getArrivalTime();
+        }
+        if (!events_.empty()) {
+            event_time = std::min(event_time, events_.top().first);
+        }
+        if (event_time == std::numeric_limits<float>::infinity()) {
+            std::cerr << "Error: " << result.policy << " left " << waiting_.size()
+                      << " jobs waiting on an idle machine\n";
+            return result;
+        }
+        now_ = std::max(now_, event_time);
+
+        while (!events_.empty() && events_.top().first <= now_) {
+            const int job_id = events_.top().second;
+            events_.pop();
+            finishThread(job_id, result);
+        }
+
+        for (; next < jobs.size() && jobs[next].getArrivalTime() <= now_; ++next) {
+            if (jobs[next].getNumThreads() > config_.num_cores) {
+                ++result.skipped_jobs;
+                continue;
+            }
+            jobs[next].setState(JobState::READY);
+            waiting_.push_back(std::move(jobs[next]));
+        }
+
+        startPendingThreads();
+        policy.schedule(*this);
+    }
+
+    if (result.skipped_jobs > 0) {
+        std::cerr << "Warning: Skipped " << result.skipped_jobs << " jobs wider than the machine's "
+                  << config_.num_cores << " cores\n";
+    }
+    result.ok = true;
+    return result;
+}
+
+bool BatchSimulator::start(std::size_t index, int cores) {
+    if (index >= waiting_.size() || cores < 1 || cores > free_cores_ ||
+        cores > waiting_[index].getNumThreads()) {
+        return false;
+    }
+
+    BatchAllocation allocation{std::move(waiting_[index])};
+    waiting_.erase(waiting_.begin() + static_cast<std::ptrdiff_t>(index));
+
+    Job& job = allocation.job;
+    job.setState(JobState::RUNNING);
+    job.setStartTime(now_);
+    allocation.cores = cores;
+    allocation.threads_pending = job.getNumThreads() - cores;
+    const float end = now_ + job.getBurstTime();
+    for (int i = 0; i < cores; ++i) {
+        events_.emplace(end, job.getId());
+    }
+    free_cores_ -= cores;
+    running_.push_back(std::move(allocation));
+    return true;
+}
+
+void BatchSimulator::startPendingThreads() {
+    for (auto& allocation : running_) {
+        if (free_cores_ == 0) {
+            break;
+        }
+        const int cores = std::min(allocation.threads_pending, free_cores_);
+        if (cores == 0) {
+            continue;
+        }
+        const float end = now_ + allocation.job.getBurstTime();
+        for (int i = 0; i < cores; ++i) {
+            events_.emplace(end, allocation.job.getId());
+        }
+        allocation.cores += cores;
+        allocation.threads_pending -= cores;
+        free_cores_ -= cores;
+    }
+}
+
+void BatchSimulator::finishThread(int job_id, BatchResult& result) {
+    auto it = std::find_if(running_.begin(), running_.end(), [job_id](const BatchAllocation& a) {
+        return a.job.getId() == job_id;
+    });
+    if (it == running_.end()) {
+        return;
+    }
+
+    ++free_cores_;
+    --it->cores;
+    if (++it->threads_done < it->job.getNumThreads()) {
+        return;
+    }
+
+    Job job = std::move(it->job);
+    running_.erase(it);
+    job.setRemainingTime(0.0f);
+    job.setFinishTime(now_);
+    job.setState(JobState::FINISHED);
+    job.calculateMetrics();
+
+    result.busy_time += static_cast<double>(job.getBurstTime()) * job.getNumThreads();
+    result.makespan = std::max(result.makespan, now_);
+    result.completed_jobs.push_back(std::move(job));
+}
+
+void BatchSimulator::printSummary(const BatchResult& result, const BatchConfig& config) {
+    const auto original_flags = std::cout.flags();
+    const auto original_precision = std::cout.precision();
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Batch Machine: " << result.num_cores << " cores\n";
+    std::cout << "Batch Policy: " << result.policy << "\n";
+    std::cout << "------------------------------------------------\n";
+    std::cout << "Jobs Completed: " << result.completed_jobs.size() << "\n";
+    if (result.skipped_jobs > 0) {
+        std::cout << "Jobs Skipped: " << result.skipped_jobs << "\n";
+    }
+    std::cout << "Makespan: " << result.makespan << "\n";
+    std::cout << "Average Waiting Time: " << result.averageWaitingTime() << "\n";
+    std::cout << "Maximum Waiting Time: " << result.maxWaitingTime() << "\n";
+    std::cout << "Average Turnaround Time: " << result.averageTurnaroundTime() << "\n";
+    std::cout << "Average Bounded Slowdown: " << result.averageBoundedSlowdown(config.slowdown_bound)
+              << " (bound " << config.slowdown_bound << ")\n";
+    std::cout << "CPU Utilization: " << result.utilization() * 100.0f << "%\n";
+
+    std::cout.flags(original_flags);
+    std::cout.precision(original_precision);
+}
+
+bool BatchSimulator::comparePolicies(const BatchConfig& config) {
+    const std::vector<Job> jobs = generateWorkload(config);
+    std::vector<BatchResult> results;
+    for (const auto& name : batchPolicyNames()) {
+        auto policy = createBatchPolicy(name, config.estimate_factor);
+        BatchResult result = BatchSimulator(config).run(jobs, *policy);
+        if (!result.ok) {
+            return false;
+        }
+        results.push_back(std::move(result));
+    }
+
+    const auto original_flags = std::cout.flags();
+    const auto original_precision = std::cout.precision();
+
+    std::cout << "\n" << config.num_cores << " cores, load " << config.load << ", "
+              << config.num_jobs << " parallel jobs, estimate factor " << config.estimate_factor << "\n";
+    std::cout << std::left << std::setw(14) << "Policy" << std::right
+              << std::setw(10) << "Avg Wait" << std::setw(10) << "Max Wait"
+              << std::setw(10) << "Avg Turn" << std::setw(10) << "Avg BSLD"
+              << std::setw(10) << "Makespan"
+              << std::setw(8) << "Util" << "\n";
+    std::cout << std::fixed << std::setprecision(2);
+    for (const auto& result : results) {
+        std::cout << std::left << std::setw(14) << result.policy << std::right
+                  << std::setw(10) << result.averageWaitingTime()
+                  << std::setw(10) << result.maxWaitingTime()
+                  << std::setw(10) << result.averageTurnaroundTime()
+                  << std::setw(10) << result.averageBoundedSlowdown(config.slowdown_bound)
+                  << std::setw(10) << result.makespan
+                  << std::setw(7) << std::setprecision(1) << result.utilization() * 100.0f << "%"
+                  << std::setprecision(2) << "\n";
+    }
+
+    std::cout.flags(original_flags);
+    std::cout.precision(original_precision);
+    return true;
+}
+
+}
@@ -0,0 +1,239 @@
+#include "checkpoint.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace chronos {
+namespace {
+constexpr char SNAPSHOT_MAGIC[8] = {'C', 'H', 'R', 'O', 'N', 'O', 'S', 'K'};
+constexpr std::uint32_t SNAPSHOT_VERSION = 4;
+
+// FNV-1a over the payload catches truncated or damaged files
+std::uint32_t checksum(const std::uint8_t* data, std::size_t size) {
+    std::uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+void putJobs(ByteWriter& out, const std::vector<Job>& jobs) {
+    out.put(static_cast<std::uint64_t>(jobs.size()));
+    for (const auto& job : jobs) {
+        out.put(static_cast<std::int32_t>(job.getId()));
+        out.put(job.getArrivalTime());
+        out.put(job.getBurstTime());
+        out.put(job.getRemainingTime());
+        out.put(static_cast<std::int32_t>(job.getPriority()));
+        out.put(static_cast<std::int32_t>(job.getNumThreads()));
+        out.put(job.getRuntimeEstimate());
+        out.put(static_cast<std::uint8_t>(job.getState()));
+        out.put(job.getStartTime());
+        out.put(job.getFinishTime());
+    }
+}
+
+bool getJobs(ByteReader& in, std::vector<Job>& jobs) {
+    std::uint64_t count = 0;
+    if (!in.get(count)) {
+        return false;
+    }
+    jobs.clear();
+    for (std::uint64_t i = 0; i < count; ++i) {
+        std::int32_t id = 0;
+        std::int32_t priority = 0;
+        std::int32_t threads = 1;
+        std::uint8_t state = 0;
+        float arrival = 0.0f, burst = 0.0f, remaining = 0.0f, start = 0.0f, finish = 0.0f;
+        float estimate = 0.0f;
+        if (!in.get(id) || !in.get(arrival) || !in.get(burst) || !in.get(remaining) ||
+            !in.get(priority) || !in.get(threads) || !in.get(estimate) ||
+            !in.get(state) || !in.get(start) || !in.get(finish) ||
+            state > static_cast<std::uint8_t>(JobState::FINISHED)) {
+            return false;
+        }
+
+        Job job(id, arrival, burst, priority);
+        job.setNumThreads(threads);
+        job.setRuntimeEstimate(estimate);
+        job.setRemainingTime(remaining);
+        job.setState(static_cast<JobState>(state));
+        job.setStartTime(start);
+        job.setFinishTime(finish);
+        // Waiting/turnaround are only ever computed at completion
+        if (job.isFinished()) {
+            job.calculateMetrics();
+        }
+        jobs.push_back(job);
+    }
+    return true;
+}
+
+void putFloats(ByteWriter& out, const std::vector<float>& values) {
+    out.put(static_cast<std::uint64_t>(values.size()));
+    for (float value : values) {
+        out.put(value);
+    }
+}
+
+bool getFloats(ByteReader& in, std::vector<float>& values, std::size_t expected) {
+    std::uint64_t count = 0;
+    if (!in.get(count) || count != expected) {
+        return false;
+    }
+    values.assign(expected, 0.0f);
+    for (auto& value : values) {
+        if (!in.get(value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void putBytes(ByteWriter& out, const std::string& str) {
+    out.put(static_cast<std::uint64_t>(str.size()));
+    for (char c : str) {
+        out.put(c);
+    }
+}
+
+template <typename Container>
+bool getBytes(ByteReader& in, Container& bytes) {
+    std::uint64_t count = 0;
+    if (!in.get(count)) {
+        return false;
+    }
+    bytes.clear();
+    for (std::uint64_t i = 0; i < count; ++i) {
+        typename Container::value_type byte{};
+        if (!in.get(byte)) {
+            return false;
+        }
+        bytes.push_back(byte);
+    }
+    return true;
+}
+} // namespace
+
+bool saveSnapshot(const SimulationSnapshot& snapshot, const std::string& path) {
+    ByteWriter payload;
+    putBytes(payload, snapshot.policy_name);
+    payload.put(static_cast<std::uint64_t>(snapshot.policy_state.size()));
+    for (std::uint8_t byte : snapshot.policy_state) {
+        payload.put(byte);
+    }
+    payload.put(static_cast<std::int32_t>(snapshot.num_cores));
+    payload.put(snapshot.simulation_start);
+    payload.put(snapshot.current_time);
+    payload.put(snapshot.idle_time);
+    payload.put(snapshot.context_switches);
+    payload.put(snapshot.rejected_jobs);
+    payload.put(snapshot.shed_jobs);
+    payload.put(snapshot.wasted_time);
+    putFloats(payload, snapshot.core_clock);
+    putFloats(payload, snapshot.core_busy_time);
+    putJobs(payload, snapshot.pending);
+    putJobs(payload, snapshot.ready);
+    putJobs(payload, snapshot.completed);
+
+    const auto& bytes = payload.bytes();
+    ByteWriter header;
+    for (char c : SNAPSHOT_MAGIC) {
+        header.put(c);
+    }
+    header.put(SNAPSHOT_VERSION);
+    header.put(static_cast<std::uint64_t>(bytes.size()));
+    header.put(checksum(bytes.data(), bytes.size()));
+
+    const std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            std::cerr << "Error: Could not open " << tmp_path << " for writing\n";
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(header.bytes().data()),
+                   static_cast<std::streamsize>(header.bytes().size()));
+        file.write(reinterpret_cast<const char*>(bytes.data()),
+                   static_cast<std::streamsize>(bytes.size()));
+        if (!file.flush()) {
+            std::cerr << "Error: Failed writing checkpoint " << tmp_path << "\n";
+            return false;
+        }
+    }
+
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        std::cerr << "Error: Could not move checkpoint into place at " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+std::optional<SimulationSnapshot> loadSnapshot(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Error: Could not open checkpoint " << path << "\n";
+        return std::nullopt;
+    }
+    const std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(file)),
+                                         std::istreambuf_iterator<char>());
+
+    ByteReader header(data);
+    char magic[sizeof(SNAPSHOT_MAGIC)] = {};
+    for (char& c : magic) {
+        header.get(c);
+    }
+    std::uint32_t version = 0;
+    std::uint64_t payload_size = 0;
+    std::uint32_t expected_checksum = 0;
+    if (std::memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) != 0 ||
+        !header.get(version) || !header.get(payload_size) || !header.get(expected_checksum)) {
+        std::cerr << "Error: " << path << " is not a chronos checkpoint\n";
+        return std::nullopt;
+    }
+    if (version != SNAPSHOT_VERSION) {
+        std::cerr << "Error: Checkpoint " << path << " has version " << version
+                  << ", expected " << SNAPSHOT_VERSION << "\n";
+        return std::nullopt;
+    }
+
+    const std::size_t header_size = sizeof(SNAPSHOT_MAGIC) + sizeof(version) +
+                                    sizeof(payload_size) + sizeof(expected_checksum);
+    const std::uint8_t* payload_data = data.data() + header_size;
+    if (data.size() - header_size != payload_size ||
+        checksum(payload_data, payload_size) != expected_checksum) {
+        std::cerr << "Error: Checkpoint " << path << " is truncated or corrupt\n";
+        return std::nullopt;
+    }
+
+    SimulationSnapshot snapshot;
+    ByteReader in(payload_data, payload_size);
+    std::int32_t num_cores = 0;
+    const bool ok = getBytes(in, snapshot.policy_name) &&
+                    getBytes(in, snapshot.policy_state) &&
+                    in.get(num_cores) && num_cores > 0 &&
+                    in.get(snapshot.simulation_start) &&
+                    in.get(snapshot.current_time) &&
+                    in.get(snapshot.idle_time) &&
+                    in.get(snapshot.context_switches) &&
+                    in.get(snapshot.rejected_jobs) &&
+                    in.get(snapshot.shed_jobs) &&
+                    in.get(snapshot.wasted_time) &&
+                    getFloats(in, snapshot.core_clock, num_cores) &&
+                    getFloats(in, snapshot.core_busy_time, num_cores) &&
+                    getJobs(in, snapshot.pending) &&
+                    getJobs(in, snapshot.ready) &&
+                    getJobs(in, snapshot.completed) &&
+                    in.atEnd();
+    if (!ok) {
+        std::cerr << "Error: Checkpoint " << path << " is malformed\n";
+        return std::nullopt;
+    }
+    snapshot.num_cores = num_cores;
+    return snapshot;
+}
+
+}
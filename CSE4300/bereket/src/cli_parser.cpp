@@ -1,8 +1,10 @@
 #include "cli_parser.h"
+#include "batch_policy.h"
+#include "policy_registry.h"
+#include "scheduler_engine.h"
+
 #include <iostream>
 #include <sstream>
-#include <algorithm>
-#include <cctype>
 
 namespace chronos {
 
@@ -15,25 +17,25 @@ CLIOptions CLIParser::parse(int argc, char* argv[]) {
         return options;
     }
 
+    // Resolved after the loop, once plugins have registered their policies
+    std::string algorithm_str;
+
     for (int i = 1; i < argc; ++i) {
         std::string arg = argv[i];
 
         if (arg == "--algo" || arg == "-a") {
             if (i + 1 >= argc) { 
-                std::cerr << "Error: --algo requires a value (FCFS, SJF, Priority, RR)\n";
+                std::cerr << "Error: --algo requires a value (" << policyList() << ")\n";
                 return options;
             }
-
-            std::string algorithm_str = argv[++i];
-            auto algorithm = stringToAlgorithm(algorithm_str);
-            if (!algorithm.has_value()) {
-                std::cerr << "Error: Invalid algorithm: '" << algorithm_str << 
-                "' Must be one of FCFS, SJF, Priority, RR" << std::endl;
+            algorithm_str = argv[++i];
+        }
+        else if (arg == "--plugin") {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: --plugin requires a path\n";
                 return options;
             }
-
-            options.algorithm = algorithm.value();
-
+            options.plugins.push_back(argv[++i]);
         }
         else if (arg == "--cores" || arg == "-c") {
             if (i + 1 >= argc) {
@@ -95,18 +97,263 @@ CLIOptions CLIParser::parse(int argc, char* argv[]) {
                 return options;
             }
         }
+        else if (arg == "--time-scale") {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: --time-scale requires a value\n";
+                return options;
+            }
+
+            std::string value_str = argv[++i];
+            try {
+                float scale = std::stof(value_str);
+                if (scale < 0.0f) {
+                    std::cerr << "Error: --time-scale must not be negative\n";
+                    return options;
+                }
+                options.time_scale_ms = scale;
+            } catch (const std::exception& e) {
+                std::cerr << "Error: --time-scale value '" << value_str 
+                          << "' is not a valid number\n";
+                return options;
+            }
+        }
+        else if (arg == "--metrics-socket") {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: --metrics-socket requires a path\n";
+                return options;
+            }
+            options.metrics_socket = argv[++i];
+        }
+        else if (arg == "--metrics-interval") {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: --metrics-interval requires a value\n";
+                return options;
+            }
+
+            std::string value_str = argv[++i];
+            try {
+                int interval = std::stoi(value_str);
+                if (interval <= 0) {
+                    std::cerr << "Error: --metrics-interval must be a positive integer\n";
+                    return options;
+                }
+                options.metrics_interval_ms = interval;
+            } catch (const std::exception& e) {
+                std::cerr << "Error: --metrics-interval value '" << value_str 
+                          << "' is not a valid integer\n";
+                return options;
+            }
+        }
+        else if (arg == "--dispatch-batch") {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: --dispatch-batch requires a value\n";
+                return options;
+            }
+
+            std::string value_str = argv[++i];
+            try {
+                int batch = std::stoi(value_str);
+                if (batch <= 0) {
+                    std::cerr << "Error: --dispatch-batch must be a positive integer\n";
+                    return options;
+                }
+                options.dispatch_batch = batch;
+            } catch (const std::exception& e) {
+                std::cerr << "Error: --dispatch-batch value '" << value_str 
+                          << "' is not a valid integer\n";
+                return options;
+            }
+        }
+        else if (arg == "--queue-capacity") {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: --queue-capacity requires a value\n";
+                return options;
+            }
+
+            std::string value_str = argv[++i];
+            try {
+                int capacity = std::stoi(value_str);
+                if (capacity < 0) {
+                    std::cerr << "Error: --queue-capacity must not be negative\n";
+                    return options;
+                }
+                options.queue_capacity = capacity;
+            } catch (const std::exception& e) {
+                std::cerr << "Error: --queue-capacity value '" << value_str 
+                          << "' is not a valid integer\n";
+                return options;
+            }
+        }
+        else if (arg == "--overflow") {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: --overflow requires a value\n";
+                return options;
+            }
+            options.overflow_policy = argv[++i];
+            if (!stringToOverflowPolicy(options.overflow_policy)) {
+                std::cerr << "Error: Invalid overflow policy: '" << options.overflow_policy
+                          << "' Must be one of reject, drop-oldest, priority-shed\n";
+                return options;
+            }
+        }
+        else if (arg == "--checkpoint") {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: --checkpoint requires a path\n";
+                return options;
+            }
+            options.checkpoint_path = argv[++i];
+        }
+        else if (arg == "--checkpoint-interval") {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: --checkpoint-interval requires a value\n";
+                return options;
+            }
+
+            std::string value_str = argv[++i];
+            try {
+                int interval = std::stoi(value_str);
+                if (interval < 0) {
+                    std::cerr << "Error: --checkpoint-interval must not be negative\n";
+                    return options;
+                }
+                options.checkpoint_interval_ms = interval;
+            } catch (const std::exception& e) {
+                std::cerr << "Error: --checkpoint-interval value '" << value_str 
+                          << "' is not a valid integer\n";
+                return options;
+            }
+        }
+        else if (arg == "--resume") {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: --resume requires a path\n";
+                return options;
+            }
+            options.resume_path = argv[++i];
+        }
+        else if (arg == "--cluster-machines" || arg == "--shards") {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: " << arg << " requires a value\n";
+                return options;
+            }
+
+            std::string value_str = argv[++i];
+            try {
+                int value = std::stoi(value_str);
+                if (value <= 0) {
+                    std::cerr << "Error: " << arg << " must be a positive integer\n";
+                    return options;
+                }
+                (arg == "--shards" ? options.cluster_shards : options.cluster_machines) = value;
+            } catch (const std::exception& e) {
+                std::cerr << "Error: " << arg << " value '" << value_str 
+                          << "' is not a valid integer\n";
+                return options;
+            }
+        }
+        else if (arg == "--load" || arg == "--epoch") {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: " << arg << " requires a value\n";
+                return options;
+            }
+
+            std::string value_str = argv[++i];
+            try {
+                float value = std::stof(value_str);
+                if (value <= 0.0f) {
+                    std::cerr << "Error: " << arg << " must be positive\n";
+                    return options;
+                }
+                (arg == "--load" ? options.cluster_load : options.cluster_epoch) = value;
+            } catch (const std::exception& e) {
+                std::cerr << "Error: " << arg << " value '" << value_str 
+                          << "' is not a valid number\n";
+                return options;
+            }
+        }
+        else if (arg == "--balancer") {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: --balancer requires a value\n";
+                return options;
+            }
+            options.balancer = argv[++i];
+        }
+        else if (arg == "--batch") {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: --batch requires a policy name\n";
+                return options;
+            }
+            options.batch_policy = argv[++i];
+        }
+        else if (arg == "--estimate-factor") {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: --estimate-factor requires a value\n";
+                return options;
+            }
+
+            std::string value_str = argv[++i];
+            try {
+                float factor = std::stof(value_str);
+                if (factor <= 0.0f) {
+                    std::cerr << "Error: --estimate-factor must be positive\n";
+                    return options;
+                }
+                options.estimate_factor = factor;
+            } catch (const std::exception& e) {
+                std::cerr << "Error: --estimate-factor value '" << value_str 
+                          << "' is not a valid number\n";
+                return options;
+            }
+        }
+        else if (arg == "--compare-balancers") {
+            options.compare_balancers = true;
+        }
+        else if (arg == "--dag") {
+            options.dag = true;
+        }
         else if (arg == "--compare-all" || arg == "--compare") {
             options.compare_all = true;
-            options.algorithm = static_cast<SchedulingAlgorithm>(-1); // use sentinel value (-1) to represent "All" algorithms
+        }
+        else if (arg == "--list-policies") {
+            for (const auto& plugin : options.plugins) {
+                if (!PolicyRegistry::instance().loadPlugin(plugin)) {
+                    return options;
+                }
+            }
+            for (const auto& name : PolicyRegistry::instance().names()) {
+                std::cout << name << "\n";
+            }
+            return options;
         }
         else if (arg == "--help" || arg == "-h") {
             std::cout << "Usage: schedsim [OPTIONS]\n"
                       << "Options:\n"
-                      << "  --algo, -a <ALGO>       Scheduling algorithm (FCFS, SJF, Priority, RR)\n"
+                      << "  --algo, -a <ALGO>       Scheduling algorithm (" << policyList() << ")\n"
                       << "  --cores, -c <NUM>       Number of CPU cores (positive integer)\n"
                       << "  --jobs, -j <NUM>        Number of jobs (positive integer)\n"
                       << "  --quantum, -q <NUM>     Time quantum for Round Robin (positive integer, optional)\n"
                       << "  --compare-all           Run all algorithms and compare results\n"
+                      << "  --cluster-machines <N>  Simulate a cluster of N machines with --cores cores each\n"
+                      << "  --shards <N>            Worker processes the cluster is split across (default 1)\n"
+                      << "  --load <FRAC>           Cluster/batch offered load, fraction of capacity (default 0.8)\n"
+                      << "  --epoch <SEC>           Simulated seconds between shard synchronizations (default 1)\n"
+                      << "  --balancer <NAME>       Cluster load balancer: random, round-robin, jsq,\n"
+                      << "                          power-of-two, least-work-left (default round-robin)\n"
+                      << "  --compare-balancers     Run the cluster workload under every load balancer\n"
+                      << "  --batch <POLICY>        Gang-schedule parallel jobs on --cores cores: gang, relaxed,\n"
+                      << "                          backfill, easy, conservative (--compare-all runs every one)\n"
+                      << "  --estimate-factor <F>   Scale runtime estimates in easy/conservative (default 1)\n"
+                      << "  --dag                   Give jobs random predecessors (try --algo CriticalPath)\n"
+                      << "  --plugin <PATH>         Load scheduling policies from a shared object (repeatable)\n"
+                      << "  --list-policies         List registered policy names (after --plugin) and exit\n"
+                      << "  --time-scale <MS>       Wall ms per simulated second (default 1000, 0 = no sleeping)\n"
+                      << "  --metrics-socket <PATH> Publish live JSON snapshots to a Unix datagram socket\n"
+                      << "  --metrics-interval <MS> Milliseconds between live snapshots (default 1000)\n"
+                      << "  --dispatch-batch <K>    Let a core take up to K ready jobs per lock hold (default 1)\n"
+                      << "  --queue-capacity <N>    Bound the ready queue to N waiting jobs (default 0 = unbounded)\n"
+                      << "  --overflow <POLICY>     Full queue handling: reject, drop-oldest, priority-shed\n"
+                      << "  --checkpoint <PATH>     Checkpoint file, written on SIGTERM/SIGINT before exiting\n"
+                      << "  --checkpoint-interval <MS> Also checkpoint every MS wall-clock milliseconds\n"
+                      << "  --resume <PATH>         Continue a run from a checkpoint (same --algo/--quantum)\n"
                       << "  --help, -h              Show this help message\n";
             options.is_valid = false;  // Help doesn't run the program
             return options;
@@ -118,6 +365,25 @@ CLIOptions CLIParser::parse(int argc, char* argv[]) {
         }
     }
 
+    PolicyRegistry& registry = PolicyRegistry::instance();
+    for (const auto& plugin : options.plugins) {
+        if (!registry.loadPlugin(plugin)) {
+            return options;
+        }
+    }
+
+    if (options.compare_all) {
+        options.algorithm = "All";
+    } else if (!algorithm_str.empty()) {
+        auto algorithm = registry.canonicalName(algorithm_str);
+        if (!algorithm.has_value()) {
+            std::cerr << "Error: Invalid algorithm: '" << algorithm_str << 
+            "' Must be one of " << policyList() << std::endl;
+            return options;
+        }
+        options.algorithm = algorithm.value();
+    }
+
     if (validateOptions(options)) {
         options.is_valid = true;
     }
@@ -135,7 +401,7 @@ void CLIParser::printOptions(const CLIOptions& options) {
     }
     
     std::cout << "Status: VALID\n";
-    std::cout << "Algorithm: " << algorithmToString(options.algorithm) << "\n";
+    std::cout << "Algorithm: " << options.algorithm << "\n";
     std::cout << "CPU Cores: " << options.num_cores << "\n";
     std::cout << "Number of Jobs: " << options.num_jobs << "\n";
     
@@ -143,43 +409,49 @@ void CLIParser::printOptions(const CLIOptions& options) {
         std::cout << "Quantum: " << options.quantum.value() << "\n";
     } else {
         std::cout << "Quantum: Not specified";
-        if (options.algorithm == SchedulingAlgorithm::RR) {
-            std::cout << " (WARNING: Required for Round Robin)";
+        if (PolicyRegistry::instance().requiresQuantum(options.algorithm)) {
+            std::cout << " (WARNING: Required for " << options.algorithm << ")";
         }
         std::cout << "\n";
     }
     
     std::cout << "Compare All: " << (options.compare_all ? "Yes" : "No") << "\n";
-    std::cout << "========================================\n";
-}
-
-std::string CLIParser::algorithmToString(const SchedulingAlgorithm& algo) {
-    switch (algo) {
-        case SchedulingAlgorithm::FCFS:     return "FCFS";
-        case SchedulingAlgorithm::SJF:      return "SJF";
-        case SchedulingAlgorithm::PRIORITY: return "Priority";
-        case SchedulingAlgorithm::RR:       return "Round Robin";
-        default:                            return "All";
+    if (options.cluster_machines > 0) {
+        std::cout << "Cluster: " << options.cluster_machines << " machines, "
+                  << options.cluster_shards << " shards, load " << options.cluster_load
+                  << ", balancer " << (options.compare_balancers ? "all" : options.balancer) << "\n";
+    }
+    if (!options.batch_policy.empty()) {
+        std::cout << "Batch: " << (options.compare_all ? "all" : options.batch_policy)
+                  << " policy, load " << options.cluster_load
+                  << ", estimate factor " << options.estimate_factor << "\n";
+    }
+    if (options.dag) {
+        std::cout << "Dependencies: random DAG\n";
+    }
+    if (options.queue_capacity > 0) {
+        std::cout << "Queue Capacity: " << options.queue_capacity
+                  << " (" << options.overflow_policy << ")\n";
+    }
+    if (!options.checkpoint_path.empty()) {
+        std::cout << "Checkpoint: " << options.checkpoint_path << "\n";
     }
+    if (!options.resume_path.empty()) {
+        std::cout << "Resume From: " << options.resume_path << "\n";
+    }
+    if (!options.metrics_socket.empty()) {
+        std::cout << "Live Metrics: " << options.metrics_socket
+                  << " every " << options.metrics_interval_ms << " ms\n";
+    }
+    std::cout << "========================================\n";
 }
 
-std::optional<SchedulingAlgorithm> CLIParser::stringToAlgorithm(const std::string& str) {
-    // Convert to uppercase for case-insensitive matching
-    std::string upper_str = str;
-    std::transform(upper_str.begin(), upper_str.end(), upper_str.begin(),
-                   [](unsigned char c) { return std::toupper(c); });
-    
-    if (upper_str == "FCFS") {
-        return SchedulingAlgorithm::FCFS;
-    } else if (upper_str == "SJF") {
-        return SchedulingAlgorithm::SJF;
-    } else if (upper_str == "PRIORITY" || upper_str == "PRI") {
-        return SchedulingAlgorithm::PRIORITY;
-    } else if (upper_str == "RR" || upper_str == "ROUNDROBIN") {
-        return SchedulingAlgorithm::RR;
+std::string CLIParser::policyList() {
+    std::string list;
+    for (const auto& name : PolicyRegistry::instance().names()) {
+        list += (list.empty() ? "" : ", ") + name;
     }
-    
-    return std::nullopt;
+    return list;
 }
 
 bool CLIParser::validateOptions(const CLIOptions& options) {
@@ -189,19 +461,69 @@ bool CLIParser::validateOptions(const CLIOptions& options) {
         return false;
     }
     
-    if (options.num_jobs <= 0) {
+    // A resumed run takes its jobs and cores from the checkpoint
+    if (options.num_jobs <= 0 && options.resume_path.empty()) {
         std::cerr << "Error: --jobs is required and must be positive\n";
         return false;
     }
+
+    if (options.compare_all && (!options.checkpoint_path.empty() || !options.resume_path.empty())) {
+        std::cerr << "Error: --checkpoint and --resume only apply to single algorithm runs\n";
+        return false;
+    }
+
+    if (options.cluster_machines > 0 &&
+        (options.compare_all || !options.checkpoint_path.empty() || !options.resume_path.empty())) {
+        std::cerr << "Error: Cluster mode does not support --compare-all, --checkpoint or --resume\n";
+        return false;
+    }
+
+    if (!options.batch_policy.empty()) {
+        if (options.cluster_machines > 0 || !options.checkpoint_path.empty() ||
+            !options.resume_path.empty()) {
+            std::cerr << "Error: Batch mode does not support --cluster-machines, --checkpoint or --resume\n";
+            return false;
+        }
+        if (!createBatchPolicy(options.batch_policy)) {
+            std::cerr << "Error: Invalid batch policy: '" << options.batch_policy << "' Must be one of";
+            for (const auto& name : batchPolicyNames()) {
+                std::cerr << " " << name;
+            }
+            std::cerr << "\n";
+            return false;
+        }
+    }
+
+    if (options.estimate_factor != 1.0f && options.batch_policy.empty()) {
+        std::cerr << "Error: --estimate-factor requires --batch\n";
+        return false;
+    }
+
+    if (options.dag && (options.cluster_machines > 0 || !options.batch_policy.empty() ||
+                        !options.checkpoint_path.empty() || !options.resume_path.empty())) {
+        std::cerr << "Error: --dag does not support --cluster-machines, --batch, --checkpoint or --resume\n";
+        return false;
+    }
+
+    if (options.compare_balancers && options.cluster_machines <= 0) {
+        std::cerr << "Error: --compare-balancers requires --cluster-machines\n";
+        return false;
+    }
+
+    if (options.checkpoint_interval_ms > 0 && options.checkpoint_path.empty()) {
+        std::cerr << "Error: --checkpoint-interval requires --checkpoint\n";
+        return false;
+    }
     
-    // If Round Robin is selected, quantum should be specified
-    if (options.algorithm == SchedulingAlgorithm::RR && !options.quantum.has_value()) {
-        std::cerr << "Error: --quantum is required when using Round Robin (RR) algorithm\n";
+    // Time-sliced policies (RR and friends) need a quantum
+    const bool requires_quantum = PolicyRegistry::instance().requiresQuantum(options.algorithm);
+    if (requires_quantum && !options.quantum.has_value()) {
+        std::cerr << "Error: --quantum is required when using the " << options.algorithm << " algorithm\n";
         return false;
     }
     
-    if (!options.compare_all && options.quantum.has_value() && options.algorithm != SchedulingAlgorithm::RR) {
-        std::cout << "Warning: --quantum specified but algorithm is not Round Robin. "
+    if (!options.compare_all && options.quantum.has_value() && !requires_quantum) {
+        std::cout << "Warning: --quantum specified but algorithm is not time-sliced. "
                   << "Quantum will be ignored.\n";
     }
     
@@ -0,0 +1,528 @@
+#include "cluster_simulator.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <vector>
+
+#ifndef _WIN32
+#include <semaphore.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+
+namespace chronos {
+
+double ClusterResult::averageWaitingTime() const {
+    return totals.jobs_completed == 0 ? 0.0
+        : totals.total_waiting_time / static_cast<double>(totals.jobs_completed);
+}
+
+double ClusterResult::averageTurnaroundTime() const {
+    return totals.jobs_completed == 0 ? 0.0
+        : totals.total_turnaround_time / static_cast<double>(totals.jobs_completed);
+}
+
+double ClusterResult::utilization(int cores_per_machine) const {
+    const double capacity = static_cast<double>(makespan) * num_machines * cores_per_machine;
+    return capacity > 0.0 ? std::min(1.0, totals.busy_time / capacity) : 0.0;
+}
+
+ClusterSimulator::ClusterSimulator(ClusterConfig config)
+    : config_(std::move(config)) {}
+
+void ClusterSimulator::printSummary(const ClusterResult& result, const ClusterConfig& config) {
+    const auto original_flags = std::cout.flags();
+    const auto original_precision = std::cout.precision();
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Cluster: " << result.num_machines << " machines x "
+              << config.cores_per_machine << " cores, " << result.num_shards << " shards\n";
+    std::cout << "Load Balancer: " << result.balancer << "\n";
+    std::cout << "------------------------------------------------\n";
+    std::cout << "Jobs Completed: " << result.totals.jobs_completed << "\n";
+    std::cout << "Makespan: " << result.makespan << "\n";
+    std::cout << "Average Waiting Time: " << result.averageWaitingTime() << "\n";
+    std::cout << "Average Turnaround Time: " << result.averageTurnaroundTime() << "\n";
+    std::cout << "Turnaround p50/p95/p99: " << result.totals.turnaround.quantile(0.50) << " / "
+              << result.totals.turnaround.quantile(0.95) << " / "
+              << result.totals.turnaround.quantile(0.99) << "\n";
+    std::cout << "Waiting p50/p95/p99: " << result.totals.waiting.quantile(0.50) << " / "
+              << result.totals.waiting.quantile(0.95) << " / "
+              << result.totals.waiting.quantile(0.99) << "\n";
+    std::cout << "CPU Utilization: " << result.utilization(config.cores_per_machine) * 100.0 << "%\n";
+    std::cout << "Context Switches: " << result.totals.context_switches << "\n";
+    std::cout << "Busy Imbalance (max/mean): " << result.busy_imbalance << "\n";
+    std::cout << "Queue Imbalance (max/mean): " << result.queue_imbalance << "\n";
+    std::cout << "Epochs: " << result.epochs << " (" << result.wall_seconds << " s wall, "
+              << std::setprecision(0)
+              << (result.wall_seconds > 0.0 ? result.totals.jobs_completed / result.wall_seconds : 0.0)
+              << " jobs/s)\n";
+
+    std::cout.flags(original_flags);
+    std::cout.precision(original_precision);
+}
+
+bool ClusterSimulator::compareBalancers(const ClusterConfig& config) {
+    std::vector<ClusterResult> results;
+    for (const auto& name : loadBalancerNames()) {
+        ClusterConfig run_config = config;
+        run_config.balancer = name;
+        std::cout << "Running " << name << "...\n";
+        ClusterResult result = ClusterSimulator(run_config).run();
+        if (!result.ok) {
+            return false;
+        }
+        results.push_back(std::move(result));
+    }
+
+    const auto original_flags = std::cout.flags();
+    const auto original_precision = std::cout.precision();
+
+    std::cout << "\n" << config.num_machines << " machines x " << config.cores_per_machine
+              << " cores, load " << config.load << ", " << config.num_jobs << " jobs\n";
+    std::cout << std::left << std::setw(16) << "Balancer" << std::right
+              << std::setw(10) << "Avg Wait" << std::setw(10) << "Avg Turn"
+              << std::setw(10) << "p95 Turn" << std::setw(10) << "p99 Turn"
+              << std::setw(10) << "Busy Imb" << std::setw(10) << "Queue Imb" << "\n";
+    std::cout << std::fixed << std::setprecision(2);
+    for (const auto& result : results) {
+        std::cout << std::left << std::setw(16) << result.balancer << std::right
+                  << std::setw(10) << result.averageWaitingTime()
+                  << std::setw(10) << result.averageTurnaroundTime()
+                  << std::setw(10) << result.totals.turnaround.quantile(0.95)
+                  << std::setw(10) << result.totals.turnaround.quantile(0.99)
+                  << std::setw(10) << result.busy_imbalance
+                  << std::setw(10) << result.queue_imbalance << "\n";
+    }
+
+    std::cout.flags(original_flags);
+    std::cout.precision(original_precision);
+    return true;
+}
+
+#ifndef _WIN32
+
+namespace {
+
+// Commands from the coordinator to the shards
+enum class ShardCommand : std::int32_t {
+    RUN_EPOCH,  // admit the inbox, simulate up to epoch_end
+    FINISH,     // admit the inbox, run every machine dry, report stats and exit
+};
+
+// A routed job in a shard inbox
+struct JobRecord {
+    std::int32_t id;
+    std::int32_t machine;   // global machine index
+    float arrival;
+    float burst;
+    std::int32_t priority;
+};
+
+// Machine state published by shards at each epoch boundary
+struct MachineState {
+    MachineLoad load;
+    std::uint64_t jobs_completed;
+    double busy_time;
+};
+
+struct ShardSlot {
+    sem_t go;               // coordinator -> shard: inbox ready
+    sem_t done;             // shard -> coordinator: epoch simulated
+    std::uint64_t inbox_count;
+    MachineStats stats;     // filled in on FINISH
+};
+
+struct ControlBlock {
+    ShardCommand command;
+    float epoch_end;
+};
+
+// Everything the coordinator and the shards share, carved out of one mapping
+class SharedRegion {
+public:
+    SharedRegion(int num_shards, int num_machines, std::size_t inbox_capacity)
+        : num_shards_(num_shards)
+        , inbox_capacity_(inbox_capacity)
+    {
+        const std::size_t control_bytes = align(sizeof(ControlBlock));
+        const std::size_t slots_bytes = align(sizeof(ShardSlot) * num_shards);
+        const std::size_t inbox_bytes = align(sizeof(JobRecord) * inbox_capacity * num_shards);
+        const std::size_t machine_bytes = align(sizeof(MachineState) * num_machines);
+        size_ = control_bytes + slots_bytes + inbox_bytes + machine_bytes;
+
+        void* base = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (base == MAP_FAILED) {
+            base_ = nullptr;
+            return;
+        }
+        base_ = static_cast<char*>(base);
+        control_ = new (base_) ControlBlock{ShardCommand::RUN_EPOCH, 0.0f};
+        slots_ = reinterpret_cast<ShardSlot*>(base_ + control_bytes);
+        inboxes_ = reinterpret_cast<JobRecord*>(base_ + control_bytes + slots_bytes);
+        machines_ = reinterpret_cast<MachineState*>(base_ + control_bytes + slots_bytes + inbox_bytes);
+
+        for (int i = 0; i < num_shards_; ++i) {
+            sem_init(&slots_[i].go, 1, 0);
+            sem_init(&slots_[i].done, 1, 0);
+            slots_[i].inbox_count = 0;
+            slots_[i].stats.clear();
+        }
+        for (int i = 0; i < num_machines; ++i) {
+            machines_[i] = MachineState{MachineLoad{0, 0.0f}, 0, 0.0};
+        }
+    }
+
+    ~SharedRegion() {
+        if (!base_) {
+            return;
+        }
+        for (int i = 0; i < num_shards_; ++i) {
+            sem_destroy(&slots_[i].go);
+            sem_destroy(&slots_[i].done);
+        }
+        munmap(base_, size_);
+    }
+
+    SharedRegion(const SharedRegion&) = delete;
+    SharedRegion& operator=(const SharedRegion&) = delete;
+
+    bool valid() const { return base_ != nullptr; }
+    ControlBlock& control() { return *control_; }
+    ShardSlot& slot(int shard) { return slots_[shard]; }
+    JobRecord* inbox(int shard) { return inboxes_ + inbox_capacity_ * shard; }
+    MachineState* machines() { return machines_; }
+    std::size_t inboxCapacity() const { return inbox_capacity_; }
+
+private:
+    static std::size_t align(std::size_t bytes) {
+        constexpr std::size_t alignment = 64;
+        return (bytes + alignment - 1) / alignment * alignment;
+    }
+
+    int num_shards_;
+    std::size_t inbox_capacity_;
+    std::size_t size_ = 0;
+    char* base_ = nullptr;
+    ControlBlock* control_ = nullptr;
+    ShardSlot* slots_ = nullptr;
+    JobRecord* inboxes_ = nullptr;
+    MachineState* machines_ = nullptr;
+};
+
+// Contiguous block of machines owned by a shard
+int firstMachine(int shard, int num_machines, int num_shards) {
+    return static_cast<int>(static_cast<long long>(shard) * num_machines / num_shards);
+}
+
+int shardOf(int machine, int num_machines, int num_shards) {
+    int shard = static_cast<int>(static_cast<long long>(machine) * num_shards / num_machines);
+    while (firstMachine(shard + 1, num_machines, num_shards) <= machine) {
+        ++shard;
+    }
+    while (firstMachine(shard, num_machines, num_shards) > machine) {
+        --shard;
+    }
+    return shard;
+}
+
+void waitSemaphore(sem_t& sem) {
+    while (sem_wait(&sem) != 0 && errno == EINTR) {
+    }
+}
+
+// Shard process body: simulate machines [first, last) epoch by epoch
+void runShard(SharedRegion& shared, const ClusterConfig& config, int shard) {
+    const int first = firstMachine(shard, config.num_machines, config.num_shards);
+    const int last = firstMachine(shard + 1, config.num_machines, config.num_shards);
+
+    std::vector<MachineModel> machines;
+    machines.reserve(static_cast<std::size_t>(last - first));
+    for (int m = first; m < last; ++m) {
+        machines.emplace_back(config.cores_per_machine, config.policy_factory());
+    }
+
+    ShardSlot& slot = shared.slot(shard);
+    while (true) {
+        waitSemaphore(slot.go);
+        const ShardCommand command = shared.control().command;
+
+        const JobRecord* inbox = shared.inbox(shard);
+        for (std::uint64_t i = 0; i < slot.inbox_count; ++i) {
+            const JobRecord& record = inbox[i];
+            machines[static_cast<std::size_t>(record.machine - first)].admit(
+                Job(record.id, record.arrival, record.burst, record.priority));
+        }
+
+        MachineState* states = shared.machines();
+        for (std::size_t i = 0; i < machines.size(); ++i) {
+            if (command == ShardCommand::FINISH) {
+                machines[i].drain();
+            } else {
+                machines[i].advanceTo(shared.control().epoch_end);
+            }
+            const MachineStats& stats = machines[i].stats();
+            states[first + static_cast<int>(i)] = MachineState{
+                MachineLoad{static_cast<std::uint32_t>(machines[i].queueLength()), machines[i].workLeft()},
+                stats.jobs_completed, stats.busy_time};
+        }
+
+        if (command == ShardCommand::FINISH) {
+            slot.stats.clear();
+            for (const auto& machine : machines) {
+                slot.stats.merge(machine.stats());
+            }
+            sem_post(&slot.done);
+            return;
+        }
+        sem_post(&slot.done);
+    }
+}
+
+// Poisson arrivals sized to the requested load; bursts and priorities
+// drawn like generateSampleJobs() in main.cpp
+class WorkloadGenerator {
+public:
+    explicit WorkloadGenerator(const ClusterConfig& config)
+        : gen_(config.seed)
+        , burst_dist_(1.0f, 10.0f)
+        , priority_dist_(1, 5)
+        , remaining_(config.num_jobs)
+        , next_id_(1)
+        , clock_(0.0)
+    {
+        const double mean_burst = 5.5;
+        const double capacity = static_cast<double>(config.num_machines) * config.cores_per_machine;
+        interarrival_ = std::exponential_distribution<double>(config.load * capacity / mean_burst);
+    }
+
+    bool hasNext() const { return remaining_ > 0; }
+
+    Job next() {
+        clock_ += interarrival_(gen_);
+        --remaining_;
+        return Job(next_id_++, static_cast<float>(clock_), burst_dist_(gen_), priority_dist_(gen_));
+    }
+
+private:
+    std::mt19937 gen_;
+    std::exponential_distribution<double> interarrival_;
+    std::uniform_real_distribution<float> burst_dist_;
+    std::uniform_int_distribution<int> priority_dist_;
+    std::size_t remaining_;
+    int next_id_;
+    double clock_;
+};
+
+} // namespace
+
+ClusterResult ClusterSimulator::run() {
+    ClusterResult result;
+    if (config_.num_machines <= 0 || config_.cores_per_machine <= 0 || config_.num_jobs == 0 ||
+        config_.load <= 0.0f || config_.epoch <= 0.0f || config_.inbox_capacity == 0 ||
+        !config_.policy_factory) {
+        std::cerr << "Error: Invalid cluster configuration\n";
+        return result;
+    }
+    config_.num_shards = std::max(1, std::min(config_.num_shards, config_.num_machines));
+
+    auto balancer = createLoadBalancer(config_.balancer, config_.num_machines, config_.seed + 1);
+    if (!balancer) {
+        std::cerr << "Error: Unknown load balancer '" << config_.balancer << "'. Must be one of";
+        for (const auto& name : loadBalancerNames()) {
+            std::cerr << " " << name;
+        }
+        std::cerr << "\n";
+        return result;
+    }
+    result.balancer = balancer->getName();
+    result.num_machines = config_.num_machines;
+    result.num_shards = config_.num_shards;
+
+    SharedRegion shared(config_.num_shards, config_.num_machines, config_.inbox_capacity);
+    if (!shared.valid()) {
+        std::cerr << "Error: Could not map shared memory for cluster shards: " << std::strerror(errno) << "\n";
+        return result;
+    }
+
+    const auto wall_start = std::chrono::steady_clock::now();
+
+    // Buffered output would otherwise be flushed once per process
+    std::cout.flush();
+    std::cerr.flush();
+
+    const pid_t coordinator = getpid();
+    std::vector<pid_t> shards;
+    for (int shard = 0; shard < config_.num_shards; ++shard) {
+        const pid_t pid = fork();
+        if (pid < 0) {
+            std::cerr << "Error: fork failed: " << std::strerror(errno) << "\n";
+            for (pid_t child : shards) {
+                kill(child, SIGKILL);
+                waitpid(child, nullptr, 0);
+            }
+            return result;
+        }
+        if (pid == 0) {
+            // Shards block on their semaphore, so they must not outlive a
+            // coordinator that was killed; the getppid() check covers a
+            // coordinator that died before prctl() took effect
+#ifdef __linux__
+            prctl(PR_SET_PDEATHSIG, SIGKILL);
+#endif
+            if (getppid() != coordinator) {
+                _exit(1);
+            }
+            runShard(shared, config_, shard);
+            std::cout.flush();
+            _exit(0);
+        }
+        shards.push_back(pid);
+    }
+
+    // Wait for every shard to finish the epoch; fails if one of them died
+    auto awaitShards = [&]() {
+        for (int shard = 0; shard < config_.num_shards; ++shard) {
+            while (true) {
+                timespec deadline{};
+                clock_gettime(CLOCK_REALTIME, &deadline);
+                deadline.tv_nsec += 100 * 1000 * 1000;
+                if (deadline.tv_nsec >= 1000000000L) {
+                    deadline.tv_sec += 1;
+                    deadline.tv_nsec -= 1000000000L;
+                }
+                if (sem_timedwait(&shared.slot(shard).done, &deadline) == 0) {
+                    break;
+                }
+                int status = 0;
+                if (waitpid(shards[shard], &status, WNOHANG) == shards[shard]) {
+                    std::cerr << "Error: Cluster shard " << shard << " exited unexpectedly\n";
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
+
+    auto signalShards = [&](ShardCommand command, float epoch_end) {
+        shared.control().command = command;
+        shared.control().epoch_end = epoch_end;
+        for (int shard = 0; shard < config_.num_shards; ++shard) {
+            sem_post(&shared.slot(shard).go);
+        }
+    };
+
+    WorkloadGenerator workload(config_);
+    std::vector<MachineLoad> loads(static_cast<std::size_t>(config_.num_machines));
+    double queue_imbalance_sum = 0.0;
+    std::uint64_t queue_imbalance_samples = 0;
+
+    // Refresh the balancer's view from what the shards published
+    auto publishLoads = [&]() {
+        const MachineState* states = shared.machines();
+        std::uint64_t total_queue = 0;
+        std::uint32_t max_queue = 0;
+        for (int m = 0; m < config_.num_machines; ++m) {
+            loads[m] = states[m].load;
+            total_queue += loads[m].queue_length;
+            max_queue = std::max(max_queue, loads[m].queue_length);
+        }
+        if (total_queue > 0) {
+            const double mean_queue = static_cast<double>(total_queue) / config_.num_machines;
+            queue_imbalance_sum += max_queue / mean_queue;
+            ++queue_imbalance_samples;
+        }
+        balancer->beginEpoch(loads);
+    };
+    Job next_job = workload.next();     // num_jobs > 0 was checked above
+    bool have_next = true;
+
+    bool healthy = true;
+    float epoch_start = 0.0f;
+    while (healthy && have_next) {
+        publishLoads();
+        float epoch_end = epoch_start + config_.epoch;
+        for (int shard = 0; shard < config_.num_shards; ++shard) {
+            shared.slot(shard).inbox_count = 0;
+        }
+
+        // Route this epoch's arrivals. A full inbox ends the epoch at the
+        // next arrival, so route() only ever sees jobs that get enqueued
+        while (have_next && next_job.getArrivalTime() < epoch_end) {
+            const int machine = balancer->route(next_job);
+            const int shard = shardOf(machine, config_.num_machines, config_.num_shards);
+            ShardSlot& slot = shared.slot(shard);
+            shared.inbox(shard)[slot.inbox_count++] = JobRecord{
+                next_job.getId(), machine, next_job.getArrivalTime(),
+                next_job.getBurstTime(), next_job.getPriority()};
+            have_next = workload.hasNext();
+            if (have_next) {
+                next_job = workload.next();
+            }
+            if (slot.inbox_count == shared.inboxCapacity()) {
+                if (have_next) {
+                    epoch_end = std::min(epoch_end, next_job.getArrivalTime());
+                }
+                break;
+            }
+        }
+
+        signalShards(have_next ? ShardCommand::RUN_EPOCH : ShardCommand::FINISH, epoch_end);
+        healthy = awaitShards();
+        ++result.epochs;
+        epoch_start = epoch_end;
+    }
+
+    for (pid_t pid : shards) {
+        if (!healthy) {
+            kill(pid, SIGKILL);
+        }
+        waitpid(pid, nullptr, 0);
+    }
+    if (!healthy) {
+        return result;
+    }
+
+    result.totals.clear();
+    for (int shard = 0; shard < config_.num_shards; ++shard) {
+        result.totals.merge(shared.slot(shard).stats);
+    }
+    result.makespan = result.totals.last_finish;
+
+    const MachineState* states = shared.machines();
+    double max_busy = 0.0;
+    for (int m = 0; m < config_.num_machines; ++m) {
+        max_busy = std::max(max_busy, states[m].busy_time);
+    }
+    const double mean_busy = result.totals.busy_time / config_.num_machines;
+    result.busy_imbalance = mean_busy > 0.0 ? max_busy / mean_busy : 0.0;
+    result.queue_imbalance = queue_imbalance_samples > 0
+        ? queue_imbalance_sum / static_cast<double>(queue_imbalance_samples) : 0.0;
+    result.wall_seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - wall_start).count();
+    result.ok = true;
+    return result;
+}
+
+#else
+
+ClusterResult ClusterSimulator::run() {
+    std::cerr << "Error: Cluster simulation needs fork() and is not supported on this platform\n";
+    return ClusterResult{};
+}
+
+#endif
+
+}
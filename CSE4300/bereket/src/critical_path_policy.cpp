@@ -0,0 +1,28 @@
+#include "critical_path_policy.h"
+#include <algorithm>
+
+namespace chronos {
+
+Job* CriticalPathPolicy::getNextJob(JobQueue& ready_queue) {
+    if (ready_queue.empty()) {
+        return nullptr;
+    }
+
+    auto it = std::min_element(
+        ready_queue.begin(),
+        ready_queue.end(),
+        [](const Job& a, const Job& b) {
+            if (a.getUpwardRank() != b.getUpwardRank()) {
+                return a.getUpwardRank() > b.getUpwardRank();
+            }
+            if (a.getArrivalTime() != b.getArrivalTime()) {
+                return a.getArrivalTime() < b.getArrivalTime();
+            }
+            return a.getId() < b.getId();
+        }
+    );
+
+    return (it != ready_queue.end()) ? &(*it) : nullptr;
+}
+
+}
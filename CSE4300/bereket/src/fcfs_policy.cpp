@@ -3,7 +3,7 @@
 
 namespace chronos {
 
-Job* FCFSPolicy::getNextJob(std::vector<Job>& ready_queue) {
+Job* FCFSPolicy::getNextJob(JobQueue& ready_queue) {
     if (ready_queue.empty()) {
         return nullptr;
     }
@@ -10,6 +10,10 @@ Job::Job(int id, float arrival_time, float burst_time, int priority)
     , burst_time(burst_time)
     , remaining_time(burst_time)
     , priority(priority)
+    , num_threads(1)
+    , runtime_estimate(burst_time)
+    , ready_time(arrival_time)
+    , upward_rank(burst_time)
     , state(JobState::NEW)
     , start_time(-1.0f)
     , finish_time(-1.0f)
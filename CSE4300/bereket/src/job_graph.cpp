@@ -0,0 +1,147 @@
+#include "job_graph.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace chronos {
+namespace {
+const std::vector<int> NO_JOBS;
+} // namespace
+
+void JobGraph::addDependency(int job_id, int predecessor_id) {
+    auto& predecessors = predecessors_[job_id];
+    if (std::find(predecessors.begin(), predecessors.end(), predecessor_id) != predecessors.end()) {
+        return;
+    }
+    predecessors.push_back(predecessor_id);
+    successors_[predecessor_id].push_back(job_id);
+    ++edge_count_;
+}
+
+const std::vector<int>& JobGraph::predecessors(int job_id) const {
+    auto it = predecessors_.find(job_id);
+    return it != predecessors_.end() ? it->second : NO_JOBS;
+}
+
+const std::vector<int>& JobGraph::successors(int job_id) const {
+    auto it = successors_.find(job_id);
+    return it != successors_.end() ? it->second : NO_JOBS;
+}
+
+bool JobGraph::validate(const std::vector<Job>& jobs) const {
+    std::unordered_map<int, std::size_t> in_degree;
+    in_degree.reserve(jobs.size());
+    for (const auto& job : jobs) {
+        if (!in_degree.emplace(job.getId(), 0).second) {
+            std::cerr << "Error: Job id " << job.getId() << " appears more than once\n";
+            return false;
+        }
+    }
+
+    for (const auto& [job_id, predecessors] : predecessors_) {
+        if (in_degree.find(job_id) == in_degree.end()) {
+            std::cerr << "Error: Dependency names unknown job " << job_id << "\n";
+            return false;
+        }
+        for (int predecessor : predecessors) {
+            if (in_degree.find(predecessor) == in_degree.end()) {
+                std::cerr << "Error: Job " << job_id << " depends on unknown job " << predecessor << "\n";
+                return false;
+            }
+        }
+        in_degree[job_id] = predecessors.size();
+    }
+
+    // Kahn's algorithm: anything left unvisited sits on a cycle
+    std::vector<int> frontier;
+    for (const auto& [job_id, degree] : in_degree) {
+        if (degree == 0) {
+            frontier.push_back(job_id);
+        }
+    }
+    std::size_t visited = 0;
+    while (!frontier.empty()) {
+        const int job_id = frontier.back();
+        frontier.pop_back();
+        ++visited;
+        for (int successor : successors(job_id)) {
+            if (--in_degree[successor] == 0) {
+                frontier.push_back(successor);
+            }
+        }
+    }
+    if (visited != jobs.size()) {
+        std::cerr << "Error: Job dependencies contain a cycle\n";
+        return false;
+    }
+    return true;
+}
+
+float JobGraph::assignUpwardRanks(std::vector<Job>& jobs) const {
+    std::unordered_map<int, std::size_t> index;
+    index.reserve(jobs.size());
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        index[jobs[i].getId()] = i;
+    }
+
+    // Reverse topological order: a job is ranked once all its successors are
+    std::unordered_map<int, std::size_t> out_degree;
+    std::vector<int> frontier;
+    for (const auto& job : jobs) {
+        const std::size_t degree = successors(job.getId()).size();
+        out_degree[job.getId()] = degree;
+        if (degree == 0) {
+            frontier.push_back(job.getId());
+        }
+    }
+
+    float critical_path = 0.0f;
+    while (!frontier.empty()) {
+        const int job_id = frontier.back();
+        frontier.pop_back();
+        Job& job = jobs[index[job_id]];
+
+        float longest_successor = 0.0f;
+        for (int successor : successors(job_id)) {
+            longest_successor = std::max(longest_successor, jobs[index[successor]].getUpwardRank());
+        }
+        job.setUpwardRank(job.getBurstTime() + longest_successor);
+        critical_path = std::max(critical_path, job.getUpwardRank());
+
+        for (int predecessor : predecessors(job_id)) {
+            if (--out_degree[predecessor] == 0) {
+                frontier.push_back(predecessor);
+            }
+        }
+    }
+    return critical_path;
+}
+
+DependencyTracker::DependencyTracker(const JobGraph& graph)
+    : graph_(graph) {}
+
+bool DependencyTracker::hold(Job& job) {
+    const std::size_t unfinished = graph_.predecessors(job.getId()).size();
+    if (unfinished == 0) {
+        return false;
+    }
+    held_.emplace(job.getId(), Held{std::move(job), unfinished});
+    return true;
+}
+
+void DependencyTracker::complete(const Job& job, std::vector<Job>& released) {
+    for (int successor : graph_.successors(job.getId())) {
+        auto it = held_.find(successor);
+        if (it == held_.end()) {
+            continue;
+        }
+        Held& held = it->second;
+        held.job.setReadyTime(std::max(held.job.getReadyTime(), job.getFinishTime()));
+        if (--held.unfinished == 0) {
+            released.push_back(std::move(held.job));
+            held_.erase(it);
+        }
+    }
+}
+
+}
@@ -0,0 +1,221 @@
+#include "live_metrics.h"
+#include "worker_pool.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace chronos {
+namespace {
+// Nearest-rank quantile; reorders a scratch copy so callers keep their order
+float quantile(std::vector<float>& values, float q) {
+    if (values.empty()) {
+        return 0.0f;
+    }
+    std::size_t rank = static_cast<std::size_t>(q * static_cast<float>(values.size()));
+    if (rank >= values.size()) {
+        rank = values.size() - 1;
+    }
+    std::nth_element(values.begin(), values.begin() + rank, values.end());
+    return values[rank];
+}
+} // namespace
+
+std::string MetricsSnapshot::toJson() const {
+    std::ostringstream os;
+    os << std::fixed << std::setprecision(3);
+    os << "{\"wall_seconds\":" << wall_seconds
+       << ",\"sim_time\":" << sim_time
+       << ",\"jobs_total\":" << jobs_total
+       << ",\"jobs_completed\":" << jobs_completed
+       << ",\"queue_depth\":" << queue_depth
+       << ",\"throughput\":" << throughput
+       << ",\"core_busy\":[";
+    for (std::size_t i = 0; i < core_busy.size(); ++i) {
+        os << (i == 0 ? "" : ",") << core_busy[i];
+    }
+    os << "],\"turnaround\":{\"p50\":" << turnaround_p50
+       << ",\"p95\":" << turnaround_p95
+       << ",\"p99\":" << turnaround_p99
+       << "},\"waiting\":{\"p50\":" << waiting_p50
+       << ",\"p95\":" << waiting_p95
+       << ",\"p99\":" << waiting_p99 << "}}";
+    return os.str();
+}
+
+#ifndef _WIN32
+
+LiveMetricsPublisher::LiveMetricsPublisher(const std::string& socket_path)
+    : socket_path_(socket_path)
+    , fd_(-1)
+{
+    sockaddr_un addr{};
+    if (socket_path_.empty() || socket_path_.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "Warning: Invalid metrics socket path: '" << socket_path_ << "'\n";
+        return;
+    }
+
+    fd_ = socket(AF_UNIX, SOCK_DGRAM, 0);
+    if (fd_ < 0) {
+        std::cerr << "Warning: Could not create metrics socket: " << std::strerror(errno) << "\n";
+        return;
+    }
+    fcntl(fd_, F_SETFL, fcntl(fd_, F_GETFL, 0) | O_NONBLOCK);
+}
+
+LiveMetricsPublisher::~LiveMetricsPublisher() {
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+}
+
+bool LiveMetricsPublisher::publish(const MetricsSnapshot& snapshot) {
+    if (fd_ < 0) {
+        return false;
+    }
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, socket_path_.c_str(), sizeof(addr.sun_path) - 1);
+
+    const std::string payload = snapshot.toJson() + "\n";
+    // No listener (ENOENT/ECONNREFUSED) or a full socket buffer (EAGAIN) just drops the sample
+    const ssize_t sent = sendto(fd_, payload.data(), payload.size(), 0,
+                                reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+    return sent == static_cast<ssize_t>(payload.size());
+}
+
+#else
+
+LiveMetricsPublisher::LiveMetricsPublisher(const std::string& socket_path)
+    : socket_path_(socket_path)
+    , fd_(-1)
+{
+    std::cerr << "Warning: Live metrics sockets are not supported on this platform\n";
+}
+
+LiveMetricsPublisher::~LiveMetricsPublisher() = default;
+
+bool LiveMetricsPublisher::publish(const MetricsSnapshot& /*snapshot*/) {
+    return false;
+}
+
+#endif
+
+LiveMetricsMonitor::LiveMetricsMonitor(const std::string& socket_path, int interval_ms,
+                                       std::size_t jobs_total, float simulation_start,
+                                       const JobQueue& ready_queue,
+                                       std::mutex& queue_mutex,
+                                       const JobQueue& completed_jobs,
+                                       std::mutex& completed_mutex,
+                                       const WorkerPoolBase& worker_pool)
+    : publisher_(socket_path)
+    , interval_(std::max(1, interval_ms))
+    , jobs_total_(jobs_total)
+    , simulation_start_(simulation_start)
+    , ready_queue_(ready_queue)
+    , queue_mutex_(queue_mutex)
+    , completed_jobs_(completed_jobs)
+    , completed_mutex_(completed_mutex)
+    , worker_pool_(worker_pool)
+    , jobs_seen_(0)
+    , stopping_(false)
+{
+    turnaround_times_.reserve(jobs_total);
+    waiting_times_.reserve(jobs_total);
+}
+
+LiveMetricsMonitor::~LiveMetricsMonitor() {
+    stop();
+}
+
+void LiveMetricsMonitor::start() {
+    started_at_ = std::chrono::steady_clock::now();
+    thread_ = std::thread(&LiveMetricsMonitor::monitorThread, this);
+}
+
+void LiveMetricsMonitor::stop() {
+    {
+        std::lock_guard<std::mutex> lock(stop_mutex_);
+        stopping_ = true;
+    }
+    stop_signal_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void LiveMetricsMonitor::monitorThread() {
+    std::unique_lock<std::mutex> lock(stop_mutex_);
+    while (!stopping_) {
+        stop_signal_.wait_for(lock, interval_, [this] { return stopping_; });
+
+        lock.unlock();
+        publisher_.publish(takeSnapshot());
+        lock.lock();
+    }
+}
+
+MetricsSnapshot LiveMetricsMonitor::takeSnapshot() {
+    MetricsSnapshot snapshot;
+    snapshot.jobs_total = jobs_total_;
+    snapshot.wall_seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - started_at_).count();
+
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        snapshot.queue_depth = ready_queue_.size();
+    }
+
+    // Only jobs completed since the previous snapshot need copying
+    {
+        std::lock_guard<std::mutex> lock(completed_mutex_);
+        for (; jobs_seen_ < completed_jobs_.size(); ++jobs_seen_) {
+            const Job& job = completed_jobs_[jobs_seen_];
+            turnaround_times_.push_back(job.getTurnaroundTime());
+            waiting_times_.push_back(job.getWaitingTime());
+        }
+    }
+    snapshot.jobs_completed = jobs_seen_;
+    if (snapshot.wall_seconds > 0.0) {
+        snapshot.throughput = static_cast<double>(jobs_seen_) / snapshot.wall_seconds;
+    }
+
+    // Busy fraction is measured against the furthest point any core has reached
+    const int num_cores = worker_pool_.getNumCores();
+    float sim_time = simulation_start_;
+    for (int core = 0; core < num_cores; ++core) {
+        sim_time = std::max(sim_time, worker_pool_.coreClock(core));
+    }
+    snapshot.sim_time = sim_time;
+
+    const float elapsed = sim_time - simulation_start_;
+    snapshot.core_busy.reserve(num_cores);
+    for (int core = 0; core < num_cores; ++core) {
+        const float busy = worker_pool_.coreBusyTime(core);
+        snapshot.core_busy.push_back(elapsed > 0.0f ? std::min(1.0f, busy / elapsed) : 0.0f);
+    }
+
+    std::vector<float> scratch = turnaround_times_;
+    snapshot.turnaround_p50 = quantile(scratch, 0.50f);
+    snapshot.turnaround_p95 = quantile(scratch, 0.95f);
+    snapshot.turnaround_p99 = quantile(scratch, 0.99f);
+    scratch = waiting_times_;
+    snapshot.waiting_p50 = quantile(scratch, 0.50f);
+    snapshot.waiting_p95 = quantile(scratch, 0.95f);
+    snapshot.waiting_p99 = quantile(scratch, 0.99f);
+
+    return snapshot;
+}
+
+}
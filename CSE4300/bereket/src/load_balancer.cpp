@@ -0,0 +1,178 @@
+#include "load_balancer.h"
+
+#include <algorithm>
+#include <cctype>
+#include <random>
+
+namespace chronos {
+namespace {
+
+// Uniformly random machine
+class RandomBalancer final : public ILoadBalancer {
+public:
+    RandomBalancer(int num_machines, std::uint32_t seed)
+        : gen_(seed), pick_(0, num_machines - 1) {}
+
+    std::string getName() const override { return "random"; }
+
+    int route(const Job& /*job*/) override { return pick_(gen_); }
+
+private:
+    std::mt19937 gen_;
+    std::uniform_int_distribution<int> pick_;
+};
+
+// Machines in turn
+class RoundRobinBalancer final : public ILoadBalancer {
+public:
+    explicit RoundRobinBalancer(int num_machines)
+        : num_machines_(num_machines), next_(0) {}
+
+    std::string getName() const override { return "round-robin"; }
+
+    int route(const Job& /*job*/) override {
+        const int machine = next_;
+        next_ = (next_ + 1) % num_machines_;
+        return machine;
+    }
+
+private:
+    int num_machines_;
+    int next_;
+};
+
+// Segment tree over per-machine keys answering "which machine has the
+// smallest key" in O(1) and updating a key in O(log n). Ties go to the
+// lowest machine index.
+class MinTree {
+public:
+    explicit MinTree(int size) : size_(1) {
+        while (size_ < size) {
+            size_ *= 2;
+        }
+        keys_.assign(2 * static_cast<std::size_t>(size_), INFINITY_KEY);
+        best_.assign(2 * static_cast<std::size_t>(size_), 0);
+        for (int i = 0; i < size_; ++i) {
+            best_[size_ + i] = i;
+        }
+    }
+
+    void set(int index, double key) {
+        int node = size_ + index;
+        keys_[node] = key;
+        for (node /= 2; node >= 1; node /= 2) {
+            const int left = 2 * node;
+            const int right = left + 1;
+            const int winner = keys_[right] < keys_[left] ? right : left;
+            keys_[node] = keys_[winner];
+            best_[node] = best_[winner];
+        }
+    }
+
+    double key(int index) const { return keys_[size_ + index]; }
+
+    int argmin() const { return best_[1]; }
+
+private:
+    static constexpr double INFINITY_KEY = 1e300;
+
+    int size_;
+    std::vector<double> keys_;
+    std::vector<int> best_;
+};
+
+// Shortest queue (JSQ) or least remaining work (LWL) over all machines
+class LeastLoadedBalancer final : public ILoadBalancer {
+public:
+    LeastLoadedBalancer(int num_machines, bool by_work)
+        : by_work_(by_work), tree_(num_machines) {
+        for (int i = 0; i < num_machines; ++i) {
+            tree_.set(i, 0.0);
+        }
+    }
+
+    std::string getName() const override { return by_work_ ? "least-work-left" : "jsq"; }
+
+    void beginEpoch(const std::vector<MachineLoad>& loads) override {
+        for (std::size_t i = 0; i < loads.size(); ++i) {
+            tree_.set(static_cast<int>(i), by_work_ ? loads[i].work_left
+                                                    : static_cast<double>(loads[i].queue_length));
+        }
+    }
+
+    int route(const Job& job) override {
+        const int machine = tree_.argmin();
+        tree_.set(machine, tree_.key(machine) + (by_work_ ? job.getBurstTime() : 1.0));
+        return machine;
+    }
+
+private:
+    bool by_work_;
+    MinTree tree_;
+};
+
+// Power of two choices: the shorter queue of two random machines
+class PowerOfTwoBalancer final : public ILoadBalancer {
+public:
+    PowerOfTwoBalancer(int num_machines, std::uint32_t seed)
+        : gen_(seed), pick_(0, num_machines - 1), queue_(num_machines, 0) {}
+
+    std::string getName() const override { return "power-of-two"; }
+
+    void beginEpoch(const std::vector<MachineLoad>& loads) override {
+        for (std::size_t i = 0; i < loads.size(); ++i) {
+            queue_[i] = loads[i].queue_length;
+        }
+    }
+
+    int route(const Job& /*job*/) override {
+        const int first = pick_(gen_);
+        const int second = pick_(gen_);
+        const int machine = queue_[second] < queue_[first] ? second : first;
+        ++queue_[machine];
+        return machine;
+    }
+
+private:
+    std::mt19937 gen_;
+    std::uniform_int_distribution<int> pick_;
+    std::vector<std::uint32_t> queue_;
+};
+
+std::string toLower(std::string str) {
+    std::transform(str.begin(), str.end(), str.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    return str;
+}
+
+} // namespace
+
+std::vector<std::string> loadBalancerNames() {
+    return {"random", "round-robin", "jsq", "power-of-two", "least-work-left"};
+}
+
+std::unique_ptr<ILoadBalancer> createLoadBalancer(const std::string& name, int num_machines,
+                                                  std::uint32_t seed) {
+    if (num_machines <= 0) {
+        return nullptr;
+    }
+    const std::string key = toLower(name);
+    if (key == "random") {
+        return std::make_unique<RandomBalancer>(num_machines, seed);
+    }
+    if (key == "round-robin" || key == "rr") {
+        return std::make_unique<RoundRobinBalancer>(num_machines);
+    }
+    if (key == "jsq") {
+        return std::make_unique<LeastLoadedBalancer>(num_machines, false);
+    }
+    if (key == "power-of-two" || key == "p2c") {
+        return std::make_unique<PowerOfTwoBalancer>(num_machines, seed);
+    }
+    if (key == "least-work-left" || key == "lwl") {
+        return std::make_unique<LeastLoadedBalancer>(num_machines, true);
+    }
+    return nullptr;
+}
+
+}
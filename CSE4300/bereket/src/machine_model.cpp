@@ -0,0 +1,164 @@
+#include "machine_model.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace chronos {
+namespace {
+constexpr float EPSILON = 1e-3f;
+constexpr float NEVER = std::numeric_limits<float>::infinity();
+} // namespace
+
+void MachineStats::clear() {
+    jobs_completed = 0;
+    context_switches = 0;
+    total_waiting_time = 0.0;
+    total_turnaround_time = 0.0;
+    busy_time = 0.0;
+    last_finish = 0.0f;
+    turnaround.clear();
+    waiting.clear();
+}
+
+void MachineStats::merge(const MachineStats& other) {
+    jobs_completed += other.jobs_completed;
+    context_switches += other.context_switches;
+    total_waiting_time += other.total_waiting_time;
+    total_turnaround_time += other.total_turnaround_time;
+    busy_time += other.busy_time;
+    last_finish = std::max(last_finish, other.last_finish);
+    turnaround.merge(other.turnaround);
+    waiting.merge(other.waiting);
+}
+
+MachineModel::MachineModel(int num_cores, std::unique_ptr<ISchedulingPolicy> policy)
+    : policy_(std::move(policy))
+    , cores_(static_cast<std::size_t>(num_cores))
+    , now_(0.0f)
+    , queued_work_(0.0)
+    , outstanding_jobs_(0)
+{
+    stats_.clear();
+}
+
+void MachineModel::admit(const Job& job) {
+    inbox_.push_back(job);
+    queued_work_ += job.getRemainingTime();
+    ++outstanding_jobs_;
+}
+
+float MachineModel::workLeft() const {
+    double work = queued_work_;
+    for (const auto& core : cores_) {
+        if (core.job) {
+            work += std::max(0.0f, core.free_at - now_);
+        }
+    }
+    return static_cast<float>(work);
+}
+
+void MachineModel::advanceTo(float horizon) {
+    while (true) {
+        completeSlices();
+        releaseArrivals();
+        dispatch();
+
+        // Next event: a slice ending or a job arriving
+        float next = inbox_.empty() ? NEVER : inbox_.front().getArrivalTime();
+        for (const auto& core : cores_) {
+            if (core.job) {
+                next = std::min(next, core.free_at);
+            }
+        }
+        if (next >= horizon) {
+            break;
+        }
+        now_ = std::max(now_, next);
+    }
+    if (horizon != NEVER) {
+        now_ = std::max(now_, horizon);
+    }
+}
+
+void MachineModel::drain() {
+    advanceTo(NEVER);
+}
+
+void MachineModel::completeSlices() {
+    for (auto& core : cores_) {
+        if (!core.job || core.free_at > now_) {
+            continue;
+        }
+        Job job = std::move(*core.job);
+        core.job.reset();
+
+        if (job.getRemainingTime() <= EPSILON) {
+            job.setRemainingTime(0.0f);
+            job.setFinishTime(core.free_at);
+            job.setState(JobState::FINISHED);
+            job.calculateMetrics();
+            policy_->onJobCompletion(&job, core.free_at);
+
+            --outstanding_jobs_;
+            ++stats_.jobs_completed;
+            stats_.total_waiting_time += job.getWaitingTime();
+            stats_.total_turnaround_time += job.getTurnaroundTime();
+            stats_.last_finish = std::max(stats_.last_finish, core.free_at);
+            stats_.turnaround.record(job.getTurnaroundTime());
+            stats_.waiting.record(job.getWaitingTime());
+        } else {
+            job.setState(JobState::READY);
+            ready_.push_back(job);
+            policy_->onJobCompletion(&ready_.back(), core.free_at);
+        }
+    }
+}
+
+void MachineModel::releaseArrivals() {
+    while (!inbox_.empty() && inbox_.front().getArrivalTime() <= now_) {
+        Job job = std::move(inbox_.front());
+        inbox_.pop_front();
+        job.setState(JobState::READY);
+        ready_.push_back(std::move(job));
+    }
+}
+
+void MachineModel::dispatch() {
+    const float time_slice = policy_->getTimeSlice();
+    for (auto& core : cores_) {
+        if (core.job) {
+            continue;
+        }
+        if (ready_.empty()) {
+            break;
+        }
+
+        Job* selected = policy_->getNextJob(ready_);
+        if (!selected) {
+            break;
+        }
+        const std::size_t index = static_cast<std::size_t>(selected - ready_.data());
+        Job job = ready_[index];
+        ready_.erase(ready_.begin() + static_cast<std::ptrdiff_t>(index));
+
+        if (job.getStartTime() < 0.0f) {
+            job.setStartTime(now_);
+        }
+        job.setState(JobState::RUNNING);
+
+        const float remaining = job.getRemainingTime();
+        float execution = remaining;
+        if (time_slice > 0.0f) {
+            execution = std::min(remaining, time_slice);
+        }
+        job.setRemainingTime(remaining - execution);
+        queued_work_ -= execution;
+
+        ++stats_.context_switches;
+        stats_.busy_time += execution;
+        core.free_at = now_ + execution;
+        core.job = std::move(job);
+    }
+}
+
+}
@@ -0,0 +1,160 @@
+#include "policy_registry.h"
+
+#include "critical_path_policy.h"
+#include "fcfs_policy.h"
+#include "priority_policy.h"
+#include "rr_policy.h"
+#include "sjf_policy.h"
+
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+
+#ifndef _WIN32
+#include <dlfcn.h>
+#endif
+
+namespace chronos {
+namespace {
+std::string toUpper(std::string str) {
+    std::transform(str.begin(), str.end(), str.begin(),
+                   [](unsigned char c) { return std::toupper(c); });
+    return str;
+}
+
+using AbiVersionFn = int (*)();
+using RegisterFn = void (*)(PolicyRegistry&);
+} // namespace
+
+PolicyRegistry& PolicyRegistry::instance() {
+    static PolicyRegistry registry;
+    return registry;
+}
+
+PolicyRegistry::PolicyRegistry() {
+    registerPolicy("FCFS", [](const PolicyParams&) {
+        return std::make_unique<FCFSPolicy>();
+    });
+    registerPolicy("SJF", [](const PolicyParams&) {
+        return std::make_unique<SJFPolicy>();
+    });
+    registerPolicy("Priority", [](const PolicyParams&) {
+        return std::make_unique<PriorityPolicy>();
+    }, false, {"PRI"});
+    registerPolicy("RR", [](const PolicyParams& params) {
+        return std::make_unique<RoundRobinPolicy>(params.quantum);
+    }, true, {"ROUNDROBIN"});
+    registerPolicy("CriticalPath", [](const PolicyParams&) {
+        return std::make_unique<CriticalPathPolicy>();
+    }, false, {"HEFT"});
+}
+
+bool PolicyRegistry::registerPolicy(const std::string& name, PolicyFactory factory,
+                                    bool requires_quantum,
+                                    const std::vector<std::string>& aliases) {
+    if (name.empty() || !factory) {
+        std::cerr << "Error: Policy registration needs a name and a factory\n";
+        return false;
+    }
+
+    std::vector<std::string> keys{toUpper(name)};
+    for (const auto& alias : aliases) {
+        keys.push_back(toUpper(alias));
+    }
+    for (const auto& key : keys) {
+        if (lookup_.count(key) != 0) {
+            std::cerr << "Error: Policy name '" << key << "' is already registered\n";
+            return false;
+        }
+    }
+
+    entries_.push_back(Entry{name, std::move(factory), requires_quantum});
+    for (const auto& key : keys) {
+        lookup_[key] = entries_.size() - 1;
+    }
+    return true;
+}
+
+const PolicyRegistry::Entry* PolicyRegistry::find(const std::string& name) const {
+    auto it = lookup_.find(toUpper(name));
+    return it != lookup_.end() ? &entries_[it->second] : nullptr;
+}
+
+std::unique_ptr<ISchedulingPolicy> PolicyRegistry::create(const std::string& name,
+                                                          const PolicyParams& params) const {
+    const Entry* entry = find(name);
+    if (!entry) {
+        return nullptr;
+    }
+    try {
+        return entry->factory(params);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: Could not create policy " << entry->name << ": " << e.what() << "\n";
+        return nullptr;
+    }
+}
+
+std::optional<std::string> PolicyRegistry::canonicalName(const std::string& name) const {
+    const Entry* entry = find(name);
+    if (!entry) {
+        return std::nullopt;
+    }
+    return entry->name;
+}
+
+bool PolicyRegistry::requiresQuantum(const std::string& name) const {
+    const Entry* entry = find(name);
+    return entry && entry->requires_quantum;
+}
+
+std::vector<std::string> PolicyRegistry::names() const {
+    std::vector<std::string> result;
+    result.reserve(entries_.size());
+    for (const auto& entry : entries_) {
+        result.push_back(entry.name);
+    }
+    return result;
+}
+
+#ifndef _WIN32
+
+bool PolicyRegistry::loadPlugin(const std::string& path) {
+    void* handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!handle) {
+        std::cerr << "Error: Could not load plugin " << path << ": " << dlerror() << "\n";
+        return false;
+    }
+
+    auto abi_version = reinterpret_cast<AbiVersionFn>(dlsym(handle, "chronos_plugin_abi_version"));
+    auto register_policies = reinterpret_cast<RegisterFn>(dlsym(handle, "chronos_register_policies"));
+    if (!abi_version || !register_policies) {
+        std::cerr << "Error: " << path << " is not a chronos plugin "
+                  << "(missing chronos_plugin_abi_version or chronos_register_policies)\n";
+        dlclose(handle);
+        return false;
+    }
+
+    const int version = abi_version();
+    if (version != CHRONOS_PLUGIN_ABI_VERSION) {
+        std::cerr << "Error: Plugin " << path << " was built for ABI version " << version
+                  << ", this build expects " << CHRONOS_PLUGIN_ABI_VERSION << "\n";
+        dlclose(handle);
+        return false;
+    }
+
+    register_policies(*this);
+    plugin_handles_.push_back(handle);
+    return true;
+}
+
+#else
+
+bool PolicyRegistry::loadPlugin(const std::string& path) {
+    std::cerr << "Error: Could not load plugin " << path
+              << ": plugins are not supported on this platform\n";
+    return false;
+}
+
+#endif
+
+}
@@ -3,7 +3,7 @@
 
 namespace chronos {
 
-Job* PriorityPolicy::getNextJob(std::vector<Job>& ready_queue) {
+Job* PriorityPolicy::getNextJob(JobQueue& ready_queue) {
     if (ready_queue.empty()) {
         return nullptr;
     }
@@ -1,4 +1,5 @@
 #include "rr_policy.h"
+#include "checkpoint.h"
 
 #include <algorithm>
 #include <stdexcept>
@@ -6,14 +7,14 @@
 namespace chronos {
 
 namespace {
-    bool jobInQueue(const std::vector<Job>& ready_queue, int job_id) {
+    bool jobInQueue(const JobQueue& ready_queue, int job_id) {
         return std::any_of(
             ready_queue.begin(),
             ready_queue.end(),
             [job_id](const Job& job) { return job.getId() == job_id; });
     }
 
-    Job* findJob(std::vector<Job>& ready_queue, int job_id) {
+    Job* findJob(JobQueue& ready_queue, int job_id) {
         auto it = std::find_if(
             ready_queue.begin(),
             ready_queue.end(),
@@ -29,7 +30,7 @@ RoundRobinPolicy::RoundRobinPolicy(int quantum)
     }
 }
 
-void RoundRobinPolicy::syncRotationWithReadyQueue(const std::vector<Job>& ready_queue) {
+void RoundRobinPolicy::syncRotationWithReadyQueue(const JobQueue& ready_queue) {
     // Drop any job ids that are no longer present in the ready queue.
     rotation_.erase(
         std::remove_if(
@@ -50,7 +51,7 @@ bool RoundRobinPolicy::containsJob(int job_id) const {
     return std::find(rotation_.begin(), rotation_.end(), job_id) != rotation_.end();
 }
 
-Job* RoundRobinPolicy::getNextJob(std::vector<Job>& ready_queue) {
+Job* RoundRobinPolicy::getNextJob(JobQueue& ready_queue) {
     if (ready_queue.empty()) {
         rotation_.clear();
         return nullptr;
@@ -87,4 +88,38 @@ void RoundRobinPolicy::onJobCompletion(Job* completed_job, float /*current_time*
     }
 }
 
-} 
\ No newline at end of file
+std::vector<std::uint8_t> RoundRobinPolicy::saveState() const {
+    ByteWriter out;
+    out.put(static_cast<std::int32_t>(quantum_));
+    out.put(static_cast<std::uint64_t>(rotation_.size()));
+    for (int job_id : rotation_) {
+        out.put(static_cast<std::int32_t>(job_id));
+    }
+    return out.take();
+}
+
+bool RoundRobinPolicy::restoreState(const std::vector<std::uint8_t>& state) {
+    ByteReader in(state);
+    std::int32_t quantum = 0;
+    std::uint64_t count = 0;
+    // A different quantum would not reproduce the original run
+    if (!in.get(quantum) || quantum != quantum_ || !in.get(count)) {
+        return false;
+    }
+
+    std::deque<int> rotation;
+    for (std::uint64_t i = 0; i < count; ++i) {
+        std::int32_t job_id = 0;
+        if (!in.get(job_id)) {
+            return false;
+        }
+        rotation.push_back(job_id);
+    }
+    if (!in.atEnd()) {
+        return false;
+    }
+    rotation_ = std::move(rotation);
+    return true;
+}
+
+}
@@ -0,0 +1,27 @@
+#include "run_arena.h"
+
+namespace chronos {
+
+RunArena::RunArena(std::vector<std::byte>& buffer)
+    : resource_(buffer.data(), buffer.size(), std::pmr::new_delete_resource())
+    , bytes_used_(0)
+{
+}
+
+std::size_t RunArena::bytesUsed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bytes_used_;
+}
+
+std::size_t RunArena::requiredCapacity() const {
+    // Leave headroom so a slightly larger run still fits
+    return bytesUsed() + bytesUsed() / 4;
+}
+
+void* RunArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    bytes_used_ += bytes + alignment;
+    return resource_.allocate(bytes, alignment);
+}
+
+}
@@ -1,10 +1,23 @@
 #include "scheduler_engine.h"
+#include "checkpoint.h"
+#include "critical_path_policy.h"
+#include "fcfs_policy.h"
+#include "job_graph.h"
+#include "live_metrics.h"
+#include "priority_policy.h"
+#include "rr_policy.h"
+#include "run_arena.h"
+#include "sjf_policy.h"
 #include "worker_pool.h"
 
 #include <algorithm>
+#include <cctype>
+#include <chrono>
 #include <deque>
 #include <iomanip>
 #include <iostream>
+#include <limits>
+#include <memory>
 #include <thread>
 #include <vector>
 
@@ -12,15 +25,85 @@ namespace chronos {
 namespace {
 constexpr float EPSILON = 1e-5f;
 
+// Initial arena size: ready queue + completed jobs + pending deque per job
+constexpr std::size_t ARENA_BYTES_PER_JOB = 4 * sizeof(Job);
+constexpr std::size_t ARENA_MIN_BYTES = 16 * 1024;
+
 bool arrivalLess(const Job& lhs, const Job& rhs) {
     if (lhs.getArrivalTime() != rhs.getArrivalTime()) {
         return lhs.getArrivalTime() < rhs.getArrivalTime();
     }
     return lhs.getId() < rhs.getId();
 }
+
+// Admission order of pending jobs
+bool readyLess(const Job& lhs, const Job& rhs) {
+    if (lhs.getReadyTime() != rhs.getReadyTime()) {
+        return lhs.getReadyTime() < rhs.getReadyTime();
+    }
+    return lhs.getId() < rhs.getId();
+}
 } // namespace
 
+struct SchedulerEngine::RunContext {
+    std::pmr::deque<Job>& pending;      // owned by the scheduler thread
+    ISchedulingPolicy& policy;
+    JobQueue& ready_queue;
+    std::mutex& queue_mutex;
+    std::condition_variable& job_available;
+    std::condition_variable& scheduler_wake;   // workers: queue drained or pool idle
+    std::atomic<bool>& simulation_running;
+    JobQueue& completed_jobs;
+    std::mutex& completed_mutex;
+    std::atomic<size_t>& context_switches;
+    WorkerPoolBase& worker_pool;
+    ScheduleResult& result;
+    float simulation_start;
+    float start_time;                   // scheduler clock when the thread starts
+    DependencyTracker* dependencies;    // null without a JobGraph
+    std::size_t completions_seen;       // completed jobs already passed to dependencies
+};
+
+std::string overflowPolicyToString(OverflowPolicy policy) {
+    switch (policy) {
+        case OverflowPolicy::REJECT:        return "reject";
+        case OverflowPolicy::DROP_OLDEST:   return "drop-oldest";
+        case OverflowPolicy::PRIORITY_SHED: return "priority-shed";
+    }
+    return "unknown";
+}
+
+std::optional<OverflowPolicy> stringToOverflowPolicy(const std::string& name) {
+    std::string key = name;
+    std::transform(key.begin(), key.end(), key.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (key == "reject") {
+        return OverflowPolicy::REJECT;
+    }
+    if (key == "drop-oldest") {
+        return OverflowPolicy::DROP_OLDEST;
+    }
+    if (key == "priority-shed") {
+        return OverflowPolicy::PRIORITY_SHED;
+    }
+    return std::nullopt;
+}
+
+std::atomic<bool> SchedulerEngine::stop_requested_(false);
+
+SchedulerEngine::SchedulerEngine(EngineConfig config)
+    : config_(std::move(config)) {}
+
+void SchedulerEngine::requestStop() {
+    stop_requested_.store(true);
+}
+
 ScheduleResult SchedulerEngine::run(std::vector<Job> jobs, ISchedulingPolicy& policy, int num_cores) {
+    return run(std::move(jobs), policy, num_cores, JobGraph());
+}
+
+ScheduleResult SchedulerEngine::run(std::vector<Job> jobs, ISchedulingPolicy& policy, int num_cores,
+                                    const JobGraph& graph) {
     ScheduleResult result;
 
     if (jobs.empty()) {
@@ -33,61 +116,220 @@ ScheduleResult SchedulerEngine::run(std::vector<Job> jobs, ISchedulingPolicy& po
         return result;
     }
 
+    float critical_path = 0.0f;
+    if (!graph.empty()) {
+        if (!config_.checkpoint_path.empty()) {
+            std::cerr << "Error: Runs with job dependencies cannot be checkpointed\n";
+            return result;
+        }
+        if (!graph.validate(jobs)) {
+            return result;
+        }
+        critical_path = graph.assignUpwardRanks(jobs);
+    }
+
     // Sort jobs by arrival time
     std::sort(jobs.begin(), jobs.end(), arrivalLess);
-    const float simulation_start = jobs.front().getArrivalTime();
 
-    // Shared data structures
-    std::vector<Job> ready_queue;
-    ready_queue.reserve(jobs.size());
-    result.completed_jobs.reserve(jobs.size());
+    SimulationSnapshot state;
+    state.policy_name = policy.getName();
+    state.num_cores = num_cores;
+    state.simulation_start = jobs.front().getArrivalTime();
+    state.current_time = state.simulation_start;
+    state.core_clock.assign(num_cores, 0.0f);
+    state.core_busy_time.assign(num_cores, 0.0f);
+    state.pending = std::move(jobs);
+    result = runFrom(std::move(state), policy, graph.empty() ? nullptr : &graph);
+    result.critical_path = critical_path;
+    return result;
+}
+
+std::optional<ScheduleResult> SchedulerEngine::resume(const std::string& checkpoint_path,
+                                                      ISchedulingPolicy& policy) {
+    auto state = loadSnapshot(checkpoint_path);
+    if (!state) {
+        return std::nullopt;
+    }
+
+    if (state->policy_name != policy.getName()) {
+        std::cerr << "Error: Checkpoint was taken with policy '" << state->policy_name
+                  << "', not '" << policy.getName() << "'\n";
+        return std::nullopt;
+    }
+    if (!policy.restoreState(state->policy_state)) {
+        std::cerr << "Error: Checkpoint state does not match this " << policy.getName()
+                  << " policy (different parameters?)\n";
+        return std::nullopt;
+    }
+
+    return runFrom(std::move(*state), policy, nullptr);
+}
+
+ScheduleResult SchedulerEngine::runFrom(SimulationSnapshot state, ISchedulingPolicy& policy,
+                                        const JobGraph* graph) {
+    const std::size_t total_jobs = state.pending.size() + state.ready.size() + state.completed.size();
+
+    // First run sizes the arena from the job count; later runs reuse the
+    // buffer, grown to whatever the previous run needed
+    if (arena_buffer_.empty()) {
+        arena_buffer_.resize(ARENA_BYTES_PER_JOB * total_jobs + ARENA_MIN_BYTES);
+    }
+
+    ScheduleResult result;
+    std::size_t arena_needed = 0;
+    {
+        RunArena arena(arena_buffer_);
+        result = dispatchSimulation(std::move(state), policy, graph, arena);
+        arena_needed = arena.requiredCapacity();
+    }
+    if (arena_needed > arena_buffer_.size()) {
+        arena_buffer_.resize(arena_needed);
+    }
+
+    if (config_.print_summary && !result.interrupted) {
+        printSummary(result, policy);
+    }
+    return result;
+}
+
+ScheduleResult SchedulerEngine::dispatchSimulation(SimulationSnapshot state, ISchedulingPolicy& policy,
+                                                   const JobGraph* graph,
+                                                   std::pmr::memory_resource& arena) {
+    if (config_.specialize_policies) {
+        if (auto* fcfs = dynamic_cast<FCFSPolicy*>(&policy)) {
+            return simulate(std::move(state), *fcfs, graph, arena);
+        }
+        if (auto* sjf = dynamic_cast<SJFPolicy*>(&policy)) {
+            return simulate(std::move(state), *sjf, graph, arena);
+        }
+        if (auto* priority = dynamic_cast<PriorityPolicy*>(&policy)) {
+            return simulate(std::move(state), *priority, graph, arena);
+        }
+        if (auto* rr = dynamic_cast<RoundRobinPolicy*>(&policy)) {
+            return simulate(std::move(state), *rr, graph, arena);
+        }
+        if (auto* critical_path = dynamic_cast<CriticalPathPolicy*>(&policy)) {
+            return simulate(std::move(state), *critical_path, graph, arena);
+        }
+    }
+    return simulate(std::move(state), policy, graph, arena);
+}
+
+template <typename Policy>
+ScheduleResult SchedulerEngine::simulate(SimulationSnapshot state, Policy& policy,
+                                         const JobGraph* graph,
+                                         std::pmr::memory_resource& arena) {
+    ScheduleResult result;
+    const int num_cores = state.num_cores;
+    const float simulation_start = state.simulation_start;
+    const std::size_t total_jobs = state.pending.size() + state.ready.size() + state.completed.size();
+    result.idle_time = state.idle_time;
+    result.rejected_jobs = static_cast<std::size_t>(state.rejected_jobs);
+    result.shed_jobs = static_cast<std::size_t>(state.shed_jobs);
+    result.wasted_time = state.wasted_time;
+    // Bounded queues and dependency release both need simulated time to
+    // advance in event order, so those runs dispatch one job at a time
+    // against the scheduler's clock
+    const bool stepped = config_.queue_capacity > 0 || graph != nullptr;
+
+    // Shared data structures, all backed by the run arena
+    JobQueue ready_queue(&arena);
+    ready_queue.reserve(total_jobs);
+    ready_queue.assign(state.ready.begin(), state.ready.end());
+    result.completed_jobs.reserve(total_jobs);
     
     // Shared storage for completed jobs (thread-safe)
-    std::vector<Job> completed_jobs_shared;
-    completed_jobs_shared.reserve(jobs.size());
+    JobQueue completed_jobs_shared(&arena);
+    completed_jobs_shared.reserve(total_jobs);
+    completed_jobs_shared.assign(state.completed.begin(), state.completed.end());
     std::mutex completed_mutex;
+
+    // Arrivals not yet admitted, owned by the scheduler thread; jobs with
+    // unfinished predecessors wait in the tracker until they are released
+    std::optional<DependencyTracker> dependencies;
+    std::pmr::deque<Job> pending(&arena);
+    if (graph) {
+        dependencies.emplace(*graph);
+        for (auto& job : state.pending) {
+            if (!dependencies->hold(job)) {
+                pending.push_back(std::move(job));
+            }
+        }
+    } else {
+        pending.assign(std::make_move_iterator(state.pending.begin()),
+                       std::make_move_iterator(state.pending.end()));
+    }
+    std::vector<Job>().swap(state.pending);
+    std::vector<Job>().swap(state.ready);
+    std::vector<Job>().swap(state.completed);
     
     std::mutex queue_mutex;
     std::condition_variable job_available;
+    std::condition_variable scheduler_wake;
     std::atomic<bool> simulation_running(true);
-    std::atomic<float> current_time(simulation_start);
 
     // Create and start worker pool
-    std::atomic<size_t> context_switch_counter(0);
-    WorkerPool worker_pool(num_cores, policy, ready_queue, 
-                          queue_mutex, job_available, simulation_running,
-                          completed_jobs_shared, completed_mutex, context_switch_counter);
+    std::atomic<size_t> context_switch_counter(state.context_switches);
+    WorkerPool<Policy> worker_pool(num_cores, policy, ready_queue, 
+                          queue_mutex, job_available, scheduler_wake, simulation_running,
+                          completed_jobs_shared, completed_mutex, context_switch_counter,
+                          config_.time_scale_ms, stepped ? 1 : config_.dispatch_batch);
+    worker_pool.restoreCoreTimes(state.core_clock, state.core_busy_time);
+    if (stepped) {
+        worker_pool.setDispatchHorizon(state.current_time);
+    }
     worker_pool.start();
 
+    // Optional live snapshots for long runs
+    std::unique_ptr<LiveMetricsMonitor> monitor;
+    if (!config_.metrics_socket.empty()) {
+        monitor = std::make_unique<LiveMetricsMonitor>(
+            config_.metrics_socket, config_.metrics_interval_ms,
+            total_jobs, simulation_start,
+            ready_queue, queue_mutex, completed_jobs_shared, completed_mutex,
+            worker_pool);
+        monitor->start();
+    }
+
     // Start scheduler thread
-    std::thread scheduler(&SchedulerEngine::schedulerThread, this,
-                         std::move(jobs), std::ref(policy),
-                         std::ref(ready_queue), std::ref(queue_mutex),
-                         std::ref(job_available), std::ref(simulation_running),
-                         std::ref(result), std::ref(worker_pool));
+    RunContext ctx{pending, policy, ready_queue, queue_mutex, job_available, scheduler_wake,
+                   simulation_running, completed_jobs_shared, completed_mutex,
+                   context_switch_counter, worker_pool, result,
+                   simulation_start, state.current_time,
+                   dependencies ? &*dependencies : nullptr, completed_jobs_shared.size()};
+    std::thread scheduler(&SchedulerEngine::schedulerThread, this, std::ref(ctx));
 
     // Wait for scheduler to finish
     scheduler.join();
+    if (dependencies && dependencies->heldCount() > 0 && !result.interrupted) {
+        std::cerr << "Warning: " << dependencies->heldCount()
+                  << " jobs never had their dependencies met\n";
+    }
 
     // Stop worker threads
     simulation_running.store(false);
     job_available.notify_all();
     worker_pool.stop();
 
+    if (monitor) {
+        monitor->stop();
+    }
+
     // Collect completed jobs from shared storage
     {
         std::lock_guard<std::mutex> lock(completed_mutex);
-        result.completed_jobs = std::move(completed_jobs_shared);
+        // The result outlives the arena, so it is copied out to the heap
+        result.completed_jobs.assign(completed_jobs_shared.begin(), completed_jobs_shared.end());
     }
     
     // Collect any remaining completed jobs from ready queue
     {
         std::lock_guard<std::mutex> lock(queue_mutex);
-        collectCompletedJobs(ready_queue, result.completed_jobs, queue_mutex);
+        collectCompletedJobs(ready_queue, result.completed_jobs);
     }
 
     // Calculate final metrics from actual job completion times
-    float earliest_start = simulation_start;
+    float earliest_start = std::numeric_limits<float>::infinity();
     float latest_finish = simulation_start;
     
     for (const auto& job : result.completed_jobs) {
@@ -95,7 +337,7 @@ ScheduleResult SchedulerEngine::run(std::vector<Job> jobs, ISchedulingPolicy& po
         result.total_turnaround_time += job.getTurnaroundTime();
         result.cpu_active_time += job.getBurstTime();
         
-        if (job.getStartTime() >= 0.0f && (earliest_start == simulation_start || job.getStartTime() < earliest_start)) {
+        if (job.getStartTime() >= 0.0f && job.getStartTime() < earliest_start) {
             earliest_start = job.getStartTime();
         }
         if (job.getFinishTime() > latest_finish) {
@@ -103,6 +345,10 @@ ScheduleResult SchedulerEngine::run(std::vector<Job> jobs, ISchedulingPolicy& po
         }
     }
     
+    if (earliest_start > latest_finish) {
+        earliest_start = latest_finish;     // nothing ran
+    }
+
     // Makespan = time from first job start to last job finish
     result.makespan = latest_finish - earliest_start;
     if (result.makespan < EPSILON) {
@@ -114,68 +360,230 @@ ScheduleResult SchedulerEngine::run(std::vector<Job> jobs, ISchedulingPolicy& po
     result.context_switches = context_switch_counter.load();
     result.dispatch_count = result.completed_jobs.size();
 
-    printSummary(result, policy);
     return result;
 }
 
-void SchedulerEngine::schedulerThread(std::vector<Job> jobs, ISchedulingPolicy& policy,
-                                     std::vector<Job>& ready_queue,
-                                     std::mutex& queue_mutex,
-                                     std::condition_variable& job_available,
-                                     std::atomic<bool>& simulation_running,
-                                     ScheduleResult& result,
-                                     WorkerPool& worker_pool) {
-    std::deque<Job> pending;
-    pending.insert(pending.end(),
-                   std::make_move_iterator(jobs.begin()),
-                   std::make_move_iterator(jobs.end()));
+void SchedulerEngine::schedulerThread(RunContext& ctx) {
+    float current_time = ctx.start_time;
+    const bool stepped = config_.queue_capacity > 0 || ctx.dependencies != nullptr;
 
-    float current_time = jobs.empty() ? 0.0f : jobs.front().getArrivalTime();
-    const float simulation_start = current_time;
+    using Clock = std::chrono::steady_clock;
+    const bool checkpointing = !config_.checkpoint_path.empty();
+    const auto checkpoint_interval = std::chrono::milliseconds(config_.checkpoint_interval_ms);
+    // Stop requests come from signal handlers, which can't notify a condition
+    // variable, so checkpointing runs also wake up at this rate to look for them
+    const auto stop_poll = std::chrono::milliseconds(50);
+    auto next_checkpoint = Clock::now() + checkpoint_interval;
 
+    std::unique_lock<std::mutex> lock(ctx.queue_mutex);
     while (true) {
-        // Admit newly arrived jobs to ready queue
-        {
-            std::lock_guard<std::mutex> lock(queue_mutex);
-            while (!pending.empty() && pending.front().getArrivalTime() <= current_time + EPSILON) {
-                Job job = std::move(pending.front());
-                pending.pop_front();
-                job.setState(JobState::READY);
-                ready_queue.push_back(std::move(job));
-                job_available.notify_one(); // Notify worker threads
-            }
+        if (ctx.dependencies) {
+            releaseDependents(ctx);
         }
 
-        {
-            std::lock_guard<std::mutex> lock(queue_mutex);
-            if (pending.empty() && ready_queue.empty() && worker_pool.allIdle()) {
+        // Admit arrivals; when nothing is ready, jump simulated time to the
+        // next arrival and admit that too
+        while (true) {
+            const std::size_t admitted = admitArrivals(ctx, current_time);
+            if (admitted > 0) {
+                // Wake only as many workers as there are new jobs
+                if (admitted >= static_cast<std::size_t>(ctx.worker_pool.getNumCores())) {
+                    ctx.job_available.notify_all();
+                } else {
+                    for (std::size_t i = 0; i < admitted; ++i) {
+                        ctx.job_available.notify_one();
+                    }
+                }
+            }
+            // Stepped runs must see every running slice back first: a
+            // preempted job rejoins the queue the next arrival competes for,
+            // and a completion may release dependents earlier than it
+            if (admitted > 0 || !ctx.ready_queue.empty() || ctx.pending.empty() ||
+                (stepped && !ctx.worker_pool.allIdle())) {
                 break;
             }
-        }
-
-        // Advance time if no jobs are ready
-        if (ready_queue.empty() && !pending.empty()) {
-            const float next_arrival = pending.front().getArrivalTime();
+            const float next_arrival = ctx.pending.front().getReadyTime();
             if (next_arrival > current_time) {
-                result.idle_time += next_arrival - current_time;
+                ctx.result.idle_time += next_arrival - current_time;
                 current_time = next_arrival;
             }
         }
 
-        // Small sleep to prevent busy waiting
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        if (stepped) {
+            // Cores that are free by now may dispatch
+            ctx.worker_pool.setDispatchHorizon(current_time);
+            ctx.job_available.notify_all();
+        }
+
+        if (ctx.pending.empty() && ctx.ready_queue.empty() && ctx.worker_pool.allIdle()) {
+            break;
+        }
+
+        if (checkpointing) {
+            const bool stopping = stop_requested_.load();
+            if (stopping || (checkpoint_interval.count() > 0 && Clock::now() >= next_checkpoint)) {
+                lock.unlock();
+                writeCheckpoint(ctx, current_time, stopping);
+                lock.lock();
+                if (stopping) {
+                    ctx.result.interrupted = true;
+                    break;
+                }
+                next_checkpoint = Clock::now() + checkpoint_interval;
+                continue;
+            }
+        }
+
+        // Sleep until workers drain the ready queue (time can advance) or
+        // all go idle (run may be over). Stepped runs also need every core
+        // that is free by now to have taken a job, and every running slice
+        // back, before time moves on.
+        auto has_work = [&ctx, stepped, &current_time] {
+            if (stepped) {
+                return ctx.worker_pool.allIdle() &&
+                       (ctx.ready_queue.empty() || ctx.worker_pool.earliestCoreClock() > current_time);
+            }
+            return ctx.ready_queue.empty() && (!ctx.pending.empty() || ctx.worker_pool.allIdle());
+        };
+        if (!checkpointing) {
+            ctx.scheduler_wake.wait(lock, has_work);
+        } else {
+            auto deadline = Clock::now() + stop_poll;
+            if (checkpoint_interval.count() > 0) {
+                deadline = std::min(deadline, next_checkpoint);
+            }
+            if (!ctx.scheduler_wake.wait_until(lock, deadline, has_work)) {
+                continue;
+            }
+        }
+
+        // Every core is busy past now: step to the next core or arrival event
+        if (stepped && !ctx.ready_queue.empty()) {
+            float next_event = ctx.worker_pool.earliestCoreClock();
+            if (!ctx.pending.empty()) {
+                next_event = std::min(next_event, ctx.pending.front().getReadyTime());
+            }
+            current_time = std::max(current_time, next_event);
+        }
     }
+    lock.unlock();
 
     // Mark simulation as complete
-    simulation_running.store(false);
-    job_available.notify_all();
+    ctx.simulation_running.store(false);
+    ctx.job_available.notify_all();
 }
 
-void SchedulerEngine::collectCompletedJobs(std::vector<Job>& ready_queue,
-                                          std::vector<Job>& completed_jobs,
-                                          std::mutex& queue_mutex) {
+std::size_t SchedulerEngine::admitArrivals(RunContext& ctx, float current_time) {
+    auto first = ctx.pending.begin();
+    auto last = first;
+    while (last != ctx.pending.end() && last->getReadyTime() <= current_time + EPSILON) {
+        last->setState(JobState::READY);
+        ++last;
+    }
+
+    // Unbounded: everything that has arrived moves over in one splice
+    const std::size_t capacity = config_.queue_capacity;
+    if (capacity == 0) {
+        const std::size_t admitted = static_cast<std::size_t>(last - first);
+        ctx.ready_queue.insert(ctx.ready_queue.end(),
+                               std::make_move_iterator(first), std::make_move_iterator(last));
+        ctx.pending.erase(first, last);
+        return admitted;
+    }
+
+    std::size_t admitted = 0;
+    for (auto it = first; it != last; ++it) {
+        if (ctx.ready_queue.size() >= capacity) {
+            // Pick a queued job to shed, or turn the arrival away
+            auto victim = ctx.ready_queue.end();
+            if (config_.overflow_policy == OverflowPolicy::DROP_OLDEST) {
+                victim = std::min_element(ctx.ready_queue.begin(), ctx.ready_queue.end(), arrivalLess);
+            } else if (config_.overflow_policy == OverflowPolicy::PRIORITY_SHED) {
+                // Lowest priority, latest arrival among equals
+                victim = std::min_element(ctx.ready_queue.begin(), ctx.ready_queue.end(),
+                    [](const Job& lhs, const Job& rhs) {
+                        if (lhs.getPriority() != rhs.getPriority()) {
+                            return lhs.getPriority() < rhs.getPriority();
+                        }
+                        return arrivalLess(rhs, lhs);
+                    });
+                if (victim->getPriority() >= it->getPriority()) {
+                    victim = ctx.ready_queue.end();
+                }
+            }
+
+            if (victim == ctx.ready_queue.end()) {
+                ++ctx.result.rejected_jobs;
+                continue;
+            }
+            ctx.result.wasted_time += victim->getBurstTime() - victim->getRemainingTime();
+            ++ctx.result.shed_jobs;
+            ctx.ready_queue.erase(victim);
+        }
+        ctx.ready_queue.push_back(std::move(*it));
+        ++admitted;
+    }
+    ctx.pending.erase(first, last);
+    return admitted;
+}
+
+void SchedulerEngine::releaseDependents(RunContext& ctx) {
+    std::vector<Job> released;
+    {
+        std::lock_guard<std::mutex> completed_lock(ctx.completed_mutex);
+        for (; ctx.completions_seen < ctx.completed_jobs.size(); ++ctx.completions_seen) {
+            ctx.dependencies->complete(ctx.completed_jobs[ctx.completions_seen], released);
+        }
+    }
+
+    // Released jobs join pending in ready-time order
+    for (auto& job : released) {
+        auto position = std::upper_bound(ctx.pending.begin(), ctx.pending.end(), job, readyLess);
+        ctx.pending.insert(position, std::move(job));
+    }
+}
+
+bool SchedulerEngine::writeCheckpoint(RunContext& ctx, float current_time, bool stopping) {
+    // Let running slices finish so every job is pending, ready or completed
+    ctx.worker_pool.pauseDispatch();
+
+    SimulationSnapshot snapshot;
+    {
+        std::unique_lock<std::mutex> lock(ctx.queue_mutex);
+        ctx.scheduler_wake.wait(lock, [&ctx] { return ctx.worker_pool.allIdle(); });
+
+        snapshot.policy_name = ctx.policy.getName();
+        snapshot.policy_state = ctx.policy.saveState();
+        snapshot.num_cores = ctx.worker_pool.getNumCores();
+        snapshot.simulation_start = ctx.simulation_start;
+        snapshot.current_time = current_time;
+        snapshot.idle_time = ctx.result.idle_time;
+        snapshot.context_switches = ctx.context_switches.load();
+        snapshot.rejected_jobs = ctx.result.rejected_jobs;
+        snapshot.shed_jobs = ctx.result.shed_jobs;
+        snapshot.wasted_time = ctx.result.wasted_time;
+        for (int core = 0; core < snapshot.num_cores; ++core) {
+            snapshot.core_clock.push_back(ctx.worker_pool.coreClock(core));
+            snapshot.core_busy_time.push_back(ctx.worker_pool.coreBusyTime(core));
+        }
+        snapshot.pending.assign(ctx.pending.begin(), ctx.pending.end());
+        snapshot.ready.assign(ctx.ready_queue.begin(), ctx.ready_queue.end());
+
+        std::lock_guard<std::mutex> completed_lock(ctx.completed_mutex);
+        snapshot.completed.assign(ctx.completed_jobs.begin(), ctx.completed_jobs.end());
+    }
+
+    // Workers may continue while the file is written
+    if (!stopping) {
+        ctx.worker_pool.resumeDispatch();
+    }
+    return saveSnapshot(snapshot, config_.checkpoint_path);
+}
+
+void SchedulerEngine::collectCompletedJobs(JobQueue& ready_queue,
+                                          std::vector<Job>& completed_jobs) {
     // Separate completed jobs from ready jobs
-    std::vector<Job> still_ready;
+    JobQueue still_ready(ready_queue.get_allocator());
     for (auto& job : ready_queue) {
         if (job.getState() == JobState::FINISHED) {
             completed_jobs.push_back(std::move(job));
@@ -203,10 +611,22 @@ void SchedulerEngine::printSummary(const ScheduleResult& result, const IScheduli
     std::cout << "------------------------------------------------\n";
 
     std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Jobs Completed: " << result.completed_jobs.size() << "\n";
     std::cout << "Average Waiting Time: " << result.averageWaitingTime() << "\n";
     std::cout << "Average Turnaround Time: " << result.averageTurnaroundTime() << "\n";
     std::cout << "CPU Utilization: " << result.cpuUtilization() * 100.0f << "%\n";
     std::cout << "Context Switches: " << result.contextSwitches() << "\n";
+    if (result.critical_path > 0.0f) {
+        std::cout << "Critical Path: " << result.critical_path << " (makespan lower bound)\n";
+    }
+    if (config_.queue_capacity > 0) {
+        std::cout << "Queue Capacity: " << config_.queue_capacity
+                  << " (" << overflowPolicyToString(config_.overflow_policy) << ")\n";
+        std::cout << "Rejected / Shed Jobs: " << result.rejected_jobs << " / " << result.shed_jobs << "\n";
+        std::cout << "Shed Rate: " << result.shedRate() * 100.0f << "%\n";
+        std::cout << "Goodput: " << result.goodput() << " jobs/s\n";
+        std::cout << "Wasted CPU Time: " << result.wasted_time << "\n";
+    }
 
     std::cout.flags(original_flags);
     std::cout.precision(original_precision);
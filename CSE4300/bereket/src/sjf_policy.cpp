@@ -3,7 +3,7 @@
 
 namespace chronos {
 
-Job* SJFPolicy::getNextJob(std::vector<Job>& ready_queue) {
+Job* SJFPolicy::getNextJob(JobQueue& ready_queue) {
     if (ready_queue.empty()) {
         return nullptr;
     }
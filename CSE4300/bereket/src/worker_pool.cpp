@@ -1,47 +1,59 @@
 #include "worker_pool.h"
+#include "critical_path_policy.h"
+#include "fcfs_policy.h"
+#include "priority_policy.h"
+#include "rr_policy.h"
+#include "sjf_policy.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <iostream>
+#include <limits>
 
 namespace chronos {
 
-WorkerPool::WorkerPool(int num_cores, ISchedulingPolicy& policy,
-                       std::vector<Job>& ready_queue,
-                       std::mutex& queue_mutex,
-                       std::condition_variable& job_available,
-                       std::atomic<bool>& simulation_running,
-                       std::vector<Job>& completed_jobs,
-                       std::mutex& completed_mutex,
-                       std::atomic<size_t>& context_switches)
+WorkerPoolBase::WorkerPoolBase(int num_cores,
+                               JobQueue& ready_queue,
+                               std::mutex& queue_mutex,
+                               std::condition_variable& job_available,
+                               std::condition_variable& scheduler_wake,
+                               std::atomic<bool>& simulation_running,
+                               JobQueue& completed_jobs,
+                               std::mutex& completed_mutex,
+                               std::atomic<size_t>& context_switches,
+                               float time_scale_ms,
+                               std::size_t dispatch_batch)
     : num_cores_(num_cores)
-    , policy_(policy)
     , ready_queue_(ready_queue)
     , queue_mutex_(queue_mutex)
     , job_available_(job_available)
+    , scheduler_wake_(scheduler_wake)
     , simulation_running_(simulation_running)
     , completed_jobs_(completed_jobs)
     , completed_mutex_(completed_mutex)
     , context_switches_(context_switches)
+    , time_scale_ms_(time_scale_ms)
+    , dispatch_batch_(std::max<std::size_t>(1, dispatch_batch))
     , active_workers_(0)
+    , paused_(false)
+    , dispatch_horizon_(std::numeric_limits<float>::infinity())
     , executing_jobs_(num_cores)
+    , core_clock_(num_cores)
+    , core_busy_time_(num_cores)
 {
     for (int i = 0; i < num_cores_; ++i) {
         executing_jobs_[i].store(nullptr);
+        core_clock_[i].store(0.0f);
+        core_busy_time_[i].store(0.0f);
     }
 }
 
-WorkerPool::~WorkerPool() {
+WorkerPoolBase::~WorkerPoolBase() {
     stop();
 }
 
-void WorkerPool::start() {
-    workers_.reserve(num_cores_);
-    for (int i = 0; i < num_cores_; ++i) {
-        workers_.emplace_back(&WorkerPool::workerThread, this, i);
-    }
-}
-
-void WorkerPool::stop() {
+void WorkerPoolBase::stop() {
     for (auto& worker : workers_) {
         if (worker.joinable()) {
             worker.join();
@@ -50,123 +62,239 @@ void WorkerPool::stop() {
     workers_.clear();
 }
 
-bool WorkerPool::allIdle() const {
+void WorkerPoolBase::restoreCoreTimes(const std::vector<float>& clock,
+                                      const std::vector<float>& busy_time) {
+    for (int i = 0; i < num_cores_ && i < static_cast<int>(clock.size()); ++i) {
+        core_clock_[i].store(clock[i]);
+    }
+    for (int i = 0; i < num_cores_ && i < static_cast<int>(busy_time.size()); ++i) {
+        core_busy_time_[i].store(busy_time[i]);
+    }
+}
+
+void WorkerPoolBase::pauseDispatch() {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    paused_ = true;
+}
+
+void WorkerPoolBase::resumeDispatch() {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        paused_ = false;
+    }
+    job_available_.notify_all();
+}
+
+float WorkerPoolBase::earliestCoreClock() const {
+    float earliest = std::numeric_limits<float>::infinity();
+    for (int i = 0; i < num_cores_; ++i) {
+        earliest = std::min(earliest, core_clock_[i].load());
+    }
+    return earliest;
+}
+
+bool WorkerPoolBase::allIdle() const {
     return active_workers_.load() == 0;
 }
 
-void WorkerPool::workerThread(int core_id) {
-    // Each core tracks its own local time (when it will be free)
-    float local_core_time = 0.0f;
+void WorkerPoolBase::executeJob(Job& /*job*/, float time_slice, int /*core_id*/) {
+    // Simulate CPU execution by sleeping proportional to burst time
+    // By default 1 simulated second = 1000ms; a zero time scale skips sleeping
+    const int sleep_ms = static_cast<int>(time_slice * time_scale_ms_);
+    if (sleep_ms > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(sleep_ms));
+    }
+}
+
+template <typename Policy>
+WorkerPool<Policy>::WorkerPool(int num_cores, Policy& policy,
+                               JobQueue& ready_queue,
+                               std::mutex& queue_mutex,
+                               std::condition_variable& job_available,
+                               std::condition_variable& scheduler_wake,
+                               std::atomic<bool>& simulation_running,
+                               JobQueue& completed_jobs,
+                               std::mutex& completed_mutex,
+                               std::atomic<size_t>& context_switches,
+                               float time_scale_ms,
+                               std::size_t dispatch_batch)
+    : WorkerPoolBase(num_cores, ready_queue, queue_mutex, job_available,
+                     scheduler_wake, simulation_running, completed_jobs, completed_mutex,
+                     context_switches, time_scale_ms, dispatch_batch)
+    , policy_(policy)
+{
+}
+
+template <typename Policy>
+WorkerPool<Policy>::~WorkerPool() {
+    // Join here: the threads run code of this derived class
+    stop();
+}
+
+template <typename Policy>
+void WorkerPool<Policy>::start() {
+    workers_.reserve(num_cores_);
+    for (int i = 0; i < num_cores_; ++i) {
+        workers_.emplace_back(&WorkerPool::workerThread, this, i);
+    }
+}
+
+template <typename Policy>
+void WorkerPool<Policy>::workerThread(int core_id) {
+    // Each core tracks its own local time (when it will be free); non-zero when resuming
+    float local_core_time = core_clock_[core_id].load();
+
+    // Jobs taken in one lock hold, run back to back on this core
+    std::vector<Job> batch;
+    std::vector<float> slice_end;
+    batch.reserve(dispatch_batch_);
+    slice_end.reserve(dispatch_batch_);
     
-    while (simulation_running_.load() || !ready_queue_.empty()) {
+    // Exit is decided under the lock below; the queue must not be read unlocked
+    while (true) {
         std::unique_lock<std::mutex> lock(queue_mutex_);
         
         // Wait for jobs to be available or simulation to end
-        job_available_.wait(lock, [this] {
-            return !ready_queue_.empty() || !simulation_running_.load();
+        job_available_.wait(lock, [this, &local_core_time] {
+            return (!paused_ && !ready_queue_.empty() && local_core_time <= dispatch_horizon_) ||
+                   !simulation_running_.load();
         });
         
         // Check if we should exit
-        if (!simulation_running_.load() && ready_queue_.empty()) {
+        if (!simulation_running_.load() && (paused_ || ready_queue_.empty())) {
             break;
         }
-        
-        // Get next job from policy
-        Job* selected_job = policy_.getNextJob(ready_queue_);
-        if (!selected_job) {
-            continue;
+
+        // The policy decides how many jobs this core takes (1 unless batching is enabled)
+        const std::size_t batch_size = dispatch_batch_ > 1
+            ? policy_.dispatchBatchSize(ready_queue_.size(), num_cores_, dispatch_batch_)
+            : 1;
+
+        batch.clear();
+        while (batch.size() < batch_size && !ready_queue_.empty()) {
+            // Get next job from policy
+            Job* selected_job = policy_.getNextJob(ready_queue_);
+            if (!selected_job) {
+                break;
+            }
+            
+            // Find job in ready queue and mark as running
+            auto it = std::find_if(ready_queue_.begin(), ready_queue_.end(),
+                [selected_job](const Job& job) {
+                    return job.getId() == selected_job->getId();
+                });
+            
+            if (it == ready_queue_.end()) {
+                break;
+            }
+            
+            //Copy the job before erasing from vector to avoid dangling reference
+            batch.push_back(*it);
+            
+            // Remove job from ready queue to free the slot
+            ready_queue_.erase(it);
         }
-        
-        // Find job in ready queue and mark as running
-        auto it = std::find_if(ready_queue_.begin(), ready_queue_.end(),
-            [selected_job](const Job& job) {
-                return job.getId() == selected_job->getId();
-            });
-        
-        if (it == ready_queue_.end()) {
+        if (batch.empty()) {
             continue;
         }
-        
-        //Copy the job before erasing from vector to avoid dangling reference
-        Job job = *it;
-        
-        // Remove job from ready queue to free the slot
-        ready_queue_.erase(it);
-        
-        // Core starts job at max(its current free time, job's arrival time)
-        const float dispatch_time = std::max(local_core_time, job.getArrivalTime());
-        
-        // Set start time only once (first execution)
-        if (job.getStartTime() < 0.0f) {
-            job.setStartTime(dispatch_time);
+        if (ready_queue_.empty()) {
+            scheduler_wake_.notify_one();   // scheduler may admit the next arrivals
         }
-        
-        job.setState(JobState::RUNNING);
+
         active_workers_.fetch_add(1);
         
-        // Count this as a context switch (job dispatch to CPU)
-        context_switches_.fetch_add(1);
+        // Count each job dispatched to the CPU as a context switch
+        context_switches_.fetch_add(batch.size());
         
         // Get execution time slice
         const float time_slice = policy_.getTimeSlice();
-        const float remaining = job.getRemainingTime();
-        float execution = remaining;
-        if (time_slice > 0.0f) {
-            execution = std::min(remaining, time_slice);
-        }
-        if (execution < 0.001f) {
-            execution = remaining;
-        }
         
         lock.unlock();
-        
-        // Execute job (simulate CPU execution by sleeping)
-        executeJob(job, execution, core_id);
-        
-        // Calculate when this core finishes executing this slice
-        const float finish_time = dispatch_time + execution;
-        local_core_time = finish_time;
-        
-        float new_remaining = remaining - execution;
-        if (new_remaining < 0.001f) {
-            new_remaining = 0.0f;
+
+        slice_end.clear();
+        // Batched jobs can't be picked by other cores, so they are marked
+        // running up front; each one is dispatched when the previous finishes
+        for (auto& job : batch) {
+            job.setState(JobState::RUNNING);
+
+            // Core starts job at max(its current free time, time the job became ready)
+            const float dispatch_time = std::max(local_core_time, job.getReadyTime());
+            
+            // Set start time only once (first execution)
+            if (job.getStartTime() < 0.0f) {
+                job.setStartTime(dispatch_time);
+            }
+
+            const float remaining = job.getRemainingTime();
+            float execution = remaining;
+            if (time_slice > 0.0f) {
+                execution = std::min(remaining, time_slice);
+            }
+            if (execution < 0.001f) {
+                execution = remaining;
+            }
+            
+            // Execute job (simulate CPU execution by sleeping)
+            executeJob(job, execution, core_id);
+            
+            // Calculate when this core finishes executing this slice
+            const float finish_time = dispatch_time + execution;
+            local_core_time = finish_time;
+            slice_end.push_back(finish_time);
+            core_clock_[core_id].store(finish_time);
+            core_busy_time_[core_id].store(core_busy_time_[core_id].load() + execution);
+            
+            float new_remaining = remaining - execution;
+            if (new_remaining < 0.001f) {
+                new_remaining = 0.0f;
+                job.setFinishTime(finish_time);
+            }
+            job.setRemainingTime(new_remaining);
         }
-        job.setRemainingTime(new_remaining);
         
         // Re-acquire lock for completion handling
         lock.lock();
         
-        if (new_remaining <= 0.001f) {
-            job.setRemainingTime(0.0f);
-            job.setFinishTime(finish_time);
-            job.setState(JobState::FINISHED);
-            job.calculateMetrics();
-            policy_.onJobCompletion(&job, finish_time);
-            
-            // Add to shared completed jobs storage
-            {
-                std::lock_guard<std::mutex> completed_lock(completed_mutex_);
-                completed_jobs_.push_back(job);
+        for (std::size_t k = 0; k < batch.size(); ++k) {
+            Job& job = batch[k];
+            if (job.getRemainingTime() <= 0.001f) {
+                job.setRemainingTime(0.0f);
+                job.setState(JobState::FINISHED);
+                job.calculateMetrics();
+                policy_.onJobCompletion(&job, job.getFinishTime());
+                
+                // Add to shared completed jobs storage
+                {
+                    std::lock_guard<std::mutex> completed_lock(completed_mutex_);
+                    completed_jobs_.push_back(job);
+                }
+            } else {
+                job.setState(JobState::READY);
+                ready_queue_.push_back(job);
+                policy_.onJobCompletion(&job, slice_end[k]);
+                // Notify other workers; under a dispatch horizon only some
+                // cores may take the job, so a single wake-up can be lost
+                if (std::isinf(dispatch_horizon_)) {
+                    job_available_.notify_one();
+                } else {
+                    job_available_.notify_all();
+                }
             }
-        } else {
-            job.setState(JobState::READY);
-            ready_queue_.push_back(job);
-            policy_.onJobCompletion(&job, finish_time);
-            job_available_.notify_one(); // Notify other workers
         }
         
-        active_workers_.fetch_sub(1);
+        if (active_workers_.fetch_sub(1) == 1) {
+            scheduler_wake_.notify_one();   // pool idle: run may be over
+        }
     }
 }
 
-void WorkerPool::executeJob(Job& job, float time_slice, int core_id) {
-    // Simulate CPU execution by sleeping proportional to burst time
-    // For simulation, we use milliseconds (1 second = 1000ms)
-    const int sleep_ms = static_cast<int>(time_slice * 1000.0f);
-    if (sleep_ms > 0) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(sleep_ms));
-    }
-   
-}
+// Concrete policies get a devirtualized dispatch loop; ISchedulingPolicy
+// covers anything else (e.g. plugins)
+template class WorkerPool<ISchedulingPolicy>;
+template class WorkerPool<FCFSPolicy>;
+template class WorkerPool<SJFPolicy>;
+template class WorkerPool<PriorityPolicy>;
+template class WorkerPool<RoundRobinPolicy>;
+template class WorkerPool<CriticalPathPolicy>;
 
 }
\ No newline at end of file
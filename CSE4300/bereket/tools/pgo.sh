@@ -0,0 +1,29 @@
+#!/usr/bin/env bash
+# Profile-guided optimization build of chronos.
+#
+#   1. configure + build the instrumented pgo-generate preset
+#   2. train it by running the benchmark suite (extra args are passed to chronos_bench)
+#   3. reconfigure the same tree with pgo-use and rebuild with the profiles
+#
+# Usage: tools/pgo.sh [extra chronos_bench args...]
+set -euo pipefail
+
+cd "$(dirname "$0")/.."
+BUILD_DIR=build/pgo
+PROFILE_DIR="$BUILD_DIR/pgo-profiles"
+
+rm -rf "$PROFILE_DIR"
+cmake --preset pgo-generate
+cmake --build --preset pgo-generate -j"$(nproc 2>/dev/null || echo 4)"
+
+echo "Training with chronos_bench..."
+"$BUILD_DIR/chronos_bench" --output "$BUILD_DIR/pgo-training.csv" "$@" > /dev/null
+
+# Clang writes raw profiles that must be merged; GCC reads .gcda files directly
+if ls "$PROFILE_DIR"/*.profraw > /dev/null 2>&1; then
+    llvm-profdata merge -output="$PROFILE_DIR/default.profdata" "$PROFILE_DIR"/*.profraw
+fi
+
+cmake --preset pgo-use
+cmake --build --preset pgo-use -j"$(nproc 2>/dev/null || echo 4)"
+echo "PGO build ready: $BUILD_DIR/schedsim, $BUILD_DIR/chronos_bench"
@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+"""
+Tails live snapshots published by `schedsim --metrics-socket PATH`.
+
+Binds a Unix datagram socket at PATH and prints one line per snapshot, either
+as a compact progress line or as the raw JSON (--json) for piping into other
+tools. Start it before or during a run; snapshots sent while nothing is
+listening are dropped by the simulator.
+"""
+
+import argparse
+import json
+import os
+import socket
+import sys
+
+
+def format_snapshot(snap: dict) -> str:
+    busy = snap.get('core_busy', [])
+    avg_busy = 100.0 * sum(busy) / len(busy) if busy else 0.0
+    return (f"[{snap['wall_seconds']:9.1f}s] "
+            f"sim={snap['sim_time']:.2f} "
+            f"done={snap['jobs_completed']}/{snap['jobs_total']} "
+            f"queue={snap['queue_depth']} "
+            f"thr={snap['throughput']:.2f}/s "
+            f"busy={avg_busy:.1f}% "
+            f"turnaround p50/p95/p99="
+            f"{snap['turnaround']['p50']:.2f}/"
+            f"{snap['turnaround']['p95']:.2f}/"
+            f"{snap['turnaround']['p99']:.2f}")
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument('path', help='socket path passed to --metrics-socket')
+    parser.add_argument('--json', action='store_true', help='print raw JSON lines')
+    args = parser.parse_args()
+
+    if os.path.exists(args.path):
+        os.unlink(args.path)
+
+    sock = socket.socket(socket.AF_UNIX, socket.SOCK_DGRAM)
+    sock.bind(args.path)
+    try:
+        while True:
+            data, _ = sock.recvfrom(65536)
+            line = data.decode('utf-8').strip()
+            if args.json:
+                print(line, flush=True)
+                continue
+            try:
+                print(format_snapshot(json.loads(line)), flush=True)
+            except (ValueError, KeyError) as e:
+                print(f"Warning: malformed snapshot ({e}): {line}", file=sys.stderr)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        sock.close()
+        os.unlink(args.path)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())